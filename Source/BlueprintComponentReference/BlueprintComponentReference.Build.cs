@@ -27,5 +27,11 @@ public class BlueprintComponentReference : ModuleRules
 				"CoreUObject",
 				"Engine"
 		});
+
+		if (Target.Version.MajorVersion >= 5)
+		{
+			// fast array serializer
+			PublicDependencyModuleNames.Add("NetCore");
+		}
 	}
 }
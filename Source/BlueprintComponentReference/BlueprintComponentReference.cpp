@@ -1,15 +1,171 @@
 // Copyright 2024, Aquanox.
 
 #include "BlueprintComponentReference.h"
+#include "BlueprintComponentReferenceCache.h"
+#include "BlueprintComponentReferenceLibrary.h"
+#include "BlueprintComponentReferenceVersion.h"
+#include "ComponentReferenceLiteral.h"
 #include "Modules/ModuleManager.h"
+#include "Misc/CoreDelegates.h"
 #include "Components/ActorComponent.h"
 #include "Misc/EngineVersionComparison.h"
 #include "Engine/EngineTypes.h"
 #include "GameFramework/Actor.h"
 #include "Serialization/StructuredArchive.h"
 #include "UObject/PropertyTag.h"
+#include "UObject/CoreNet.h"
+#include "Serialization/CustomVersion.h"
+#include "Containers/StringView.h"
+#include "Misc/StringBuilder.h"
+#include "UObject/UObjectGlobals.h"
+#include <atomic>
 
-IMPLEMENT_MODULE(FDefaultModuleImpl, BlueprintComponentReference);
+class FBlueprintComponentReferenceModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override
+	{
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+		OnReloadCompleteDelegateHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason) {
+			FBlueprintComponentReferenceCache::Reset();
+		});
+		OnReloadReinstancingCompleteDelegateHandle = FCoreUObjectDelegates::ReloadReinstancingCompleteDelegate.AddStatic(&FBlueprintComponentReferenceCache::Reset);
+#endif
+		OnPostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&FBlueprintComponentReferenceCache::PruneStaleEntries);
+		OnPostGarbageCollectContainersHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&UBlueprintComponentReferenceLibrary::PruneContainerIndices);
+		FBlueprintComponentReferenceCache::StartTracking();
+#if !UE_BUILD_SHIPPING
+		// classes of declared literals are not available before that
+		OnPostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddLambda([]() {
+			FComponentReferenceLiterals::ValidateAll();
+		});
+#endif
+	}
+
+	virtual void ShutdownModule() override
+	{
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+		FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(OnReloadCompleteDelegateHandle);
+		FCoreUObjectDelegates::ReloadReinstancingCompleteDelegate.Remove(OnReloadReinstancingCompleteDelegateHandle);
+#endif
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(OnPostGarbageCollectHandle);
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(OnPostGarbageCollectContainersHandle);
+		FBlueprintComponentReferenceCache::StopTracking();
+#if !UE_BUILD_SHIPPING
+		FCoreDelegates::OnPostEngineInit.Remove(OnPostEngineInitHandle);
+#endif
+
+		FBlueprintComponentReferenceCache::Reset();
+		UBlueprintComponentReferenceLibrary::ResetContainerIndices();
+	}
+
+private:
+	FDelegateHandle OnReloadCompleteDelegateHandle;
+	FDelegateHandle OnReloadReinstancingCompleteDelegateHandle;
+	FDelegateHandle OnPostGarbageCollectHandle;
+	FDelegateHandle OnPostGarbageCollectContainersHandle;
+#if !UE_BUILD_SHIPPING
+	FDelegateHandle OnPostEngineInitHandle;
+#endif
+};
+
+IMPLEMENT_MODULE(FBlueprintComponentReferenceModule, BlueprintComponentReference);
+
+const FGuid FBlueprintComponentReferenceVersion::GUID(0x6C1A5E2B, 0x3F8D4C71, 0x9B0E27D4, 0xA5F3168C);
+
+static FCustomVersionRegistration GRegisterBlueprintComponentReferenceVersion(
+	FBlueprintComponentReferenceVersion::GUID, FBlueprintComponentReferenceVersion::LatestVersion, TEXT("BlueprintComponentReferenceVer"));
+
+namespace BCRText
+{
+	inline bool IsDelimiter(TCHAR C)
+	{
+		return C == TEXT(',') || C == TEXT(')') || C == TEXT('(') || C == TEXT('"') || C == TEXT('=') || FChar::IsWhitespace(C);
+	}
+
+	/** Value needs quoting if it can not be read back as a single token */
+	inline bool NeedsQuotes(const FName& InValue)
+	{
+		TStringBuilder<NAME_SIZE> Buffer;
+		InValue.AppendString(Buffer);
+		for (const TCHAR C : FStringView(Buffer))
+		{
+			if (IsDelimiter(C))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Parse "mode:value" or "value" token, allocates only when value is a new name
+	 */
+	inline bool ParseToken(const TCHAR* Start, int32 Len, EBlueprintComponentReferenceMode& OutMode, FName& OutValue)
+	{
+		while (Len > 0 && FChar::IsWhitespace(*Start)) { ++Start; --Len; }
+		while (Len > 0 && FChar::IsWhitespace(Start[Len - 1])) { --Len; }
+
+		if (Len == 0)
+		{
+			OutMode = EBlueprintComponentReferenceMode::None;
+			OutValue = NAME_None;
+			return true;
+		}
+
+		int32 Separator = INDEX_NONE;
+		for (int32 Index = 0; Index < Len; ++Index)
+		{
+			if (Start[Index] == TEXT(':'))
+			{
+				Separator = Index;
+				break;
+			}
+		}
+
+		if (Separator == INDEX_NONE)
+		{
+			OutMode = EBlueprintComponentReferenceMode::Property;
+			OutValue = FName(Len, Start);
+			return true;
+		}
+
+		const auto ModeEquals = [Start, Separator](const TCHAR* InMode, int32 InModeLen)
+		{
+			return Separator == InModeLen && FCString::Strnicmp(Start, InMode, InModeLen) == 0;
+		};
+
+		EBlueprintComponentReferenceMode ParsedMode;
+		if (ModeEquals(TEXT("property"), 8) || ModeEquals(TEXT("var"), 3)) // var: legacy compat
+		{
+			ParsedMode = EBlueprintComponentReferenceMode::Property;
+		}
+		else if (ModeEquals(TEXT("path"), 4))
+		{
+			ParsedMode = EBlueprintComponentReferenceMode::Path;
+		}
+		else if (ModeEquals(TEXT("nested"), 6))
+		{
+			ParsedMode = EBlueprintComponentReferenceMode::Nested;
+		}
+		else if (ModeEquals(TEXT("dynamic"), 7))
+		{
+			ParsedMode = EBlueprintComponentReferenceMode::Dynamic;
+		}
+		else
+		{
+			return false;
+		}
+
+		const TCHAR* ValueStart = Start + Separator + 1;
+		int32 ValueLen = Len - Separator - 1;
+		while (ValueLen > 0 && FChar::IsWhitespace(*ValueStart)) { ++ValueStart; --ValueLen; }
+
+		OutMode = ParsedMode;
+		OutValue = ValueLen > 0 ? FName(ValueLen, ValueStart) : NAME_None;
+		return true;
+	}
+}
 
 FBlueprintComponentReference::FBlueprintComponentReference()
 	: Mode(EBlueprintComponentReferenceMode::None)
@@ -25,55 +181,91 @@ FBlueprintComponentReference::FBlueprintComponentReference(const FString& InValu
 FBlueprintComponentReference::FBlueprintComponentReference(EBlueprintComponentReferenceMode InMode, const FName& InValue)
 	: Mode(InMode), Value(InValue)
 {
+	MarkChanged();
+}
+
+namespace BCRRevision
+{
+	// source of value revisions, zero is kept for references that were never set
+	static std::atomic<uint32> NextRevision { 1 };
+}
+
+void FBlueprintComponentReference::MarkChanged()
+{
+	Revision = BCRRevision::NextRevision.fetch_add(1, std::memory_order_relaxed);
+	if (Revision == 0)
+	{ // wrapped around
+		Revision = BCRRevision::NextRevision.fetch_add(1, std::memory_order_relaxed);
+	}
+}
 
+FBlueprintComponentReference FBlueprintComponentReference::ForTag(const FName& InTag)
+{
+	TStringBuilder<NAME_SIZE> Selector;
+	Selector.Append(TEXT("Tag:"));
+	InTag.AppendString(Selector);
+	return FBlueprintComponentReference(EBlueprintComponentReferenceMode::Dynamic, FName(Selector.Len(), Selector.GetData()));
 }
 
-bool FBlueprintComponentReference::ParseString(const FString& InValue)
+FBlueprintComponentReference FBlueprintComponentReference::ForClass(const UClass* InClass)
 {
-	FString ParsedMode, ParsedValue;
-	if (InValue.Split(TEXT(":"), &ParsedMode, &ParsedValue, ESearchCase::CaseSensitive))
+	if (!InClass)
 	{
-		if (ParsedMode.Equals(TEXT("property"), ESearchCase::IgnoreCase)
-			|| ParsedMode.Equals(TEXT("var"), ESearchCase::IgnoreCase)) // legacy compat
-		{
-			Mode = EBlueprintComponentReferenceMode::Property;
-			Value = *ParsedValue.TrimEnd();
-			return true;
-		}
-		if (ParsedMode.Equals(TEXT("path"), ESearchCase::IgnoreCase))
-        {
-        	Mode = EBlueprintComponentReferenceMode::Path;
-			Value = *ParsedValue.TrimEnd();
-			return true;
-        }
+		return FBlueprintComponentReference();
 	}
-	else if (!InValue.IsEmpty())
+
+	TStringBuilder<NAME_SIZE> Selector;
+	Selector.Append(TEXT("Class:"));
+	InClass->GetPathName(nullptr, Selector);
+	return FBlueprintComponentReference(EBlueprintComponentReferenceMode::Dynamic, FName(Selector.Len(), Selector.GetData()));
+}
+
+bool FBlueprintComponentReference::ParseString(FStringView InValue)
+{
+	EBlueprintComponentReferenceMode ParsedMode;
+	FName ParsedValue;
+	if (!BCRText::ParseToken(InValue.GetData(), InValue.Len(), ParsedMode, ParsedValue)
+		|| ParsedMode == EBlueprintComponentReferenceMode::None)
 	{
-		Mode = EBlueprintComponentReferenceMode::Property;
-		Value = *InValue.TrimStartAndEnd();
-		return true;
+		return false;
 	}
 
-	return false;
+	Mode = ParsedMode;
+	Value = ParsedValue;
+	MarkChanged();
+	return true;
 }
 
 FString FBlueprintComponentReference::ToString() const
 {
-	TStringBuilder<32> Result;
+	TStringBuilder<64> Result;
+	AppendString(Result);
+	return FString(Result.ToString());
+}
+
+void FBlueprintComponentReference::AppendString(FStringBuilderBase& Out) const
+{
 	switch (Mode)
 	{
 	case EBlueprintComponentReferenceMode::Property:
-		Result.Append(TEXT("property:"));
-		Result.Append(Value.ToString());
+		Out.Append(TEXT("property:"));
+		Value.AppendString(Out);
 		break;
 	case EBlueprintComponentReferenceMode::Path:
-		Result.Append(TEXT("path:"));
-		Result.Append(Value.ToString());
+		Out.Append(TEXT("path:"));
+		Value.AppendString(Out);
+		break;
+	case EBlueprintComponentReferenceMode::Nested:
+		Out.Append(TEXT("nested:"));
+		Value.AppendString(Out);
+		break;
+	case EBlueprintComponentReferenceMode::Dynamic:
+		Out.Append(TEXT("dynamic:"));
+		Value.AppendString(Out);
 		break;
 	default:
 		break;
 	}
-	return Result.ToString();
 }
 
 UActorComponent* FBlueprintComponentReference::ExtractComponent(AActor* SearchActor) const
@@ -86,18 +278,20 @@ UActorComponent* FBlueprintComponentReference::ExtractComponent(AActor* SearchAc
 		{
 		case EBlueprintComponentReferenceMode::Property:
 			// Variation 1: property name
-			if(FObjectPropertyBase* ObjProp = FindFProperty<FObjectPropertyBase>(SearchActor->GetClass(), Value))
-			{
-				Result = Cast<UActorComponent>(ObjProp->GetObjectPropertyValue_InContainer(SearchActor));
-			}
+			Result = Cast<UActorComponent>(FBlueprintComponentReferenceCache::FindPlan(SearchActor->GetClass(), Value).Resolve(SearchActor));
 			break;
 		case EBlueprintComponentReferenceMode::Path:
 			// Variation 2: subobject path
-			Result = FindObjectFast<UActorComponent>(SearchActor, Value);
+			Result = FBlueprintComponentReferenceCache::FindComponentByName(SearchActor, Value);
+			break;
+		case EBlueprintComponentReferenceMode::Nested:
+			// Variation 2b: path through child actors
+			Result = FBlueprintComponentReferenceCache::FindNestedComponent(SearchActor, Value);
 			break;
-		//case EBlueprintComponentReferenceMode::Dynamic:
+		case EBlueprintComponentReferenceMode::Dynamic:
 			// Variation 3: dynamic selection
-			//break;
+			Result = FBlueprintComponentReferenceCache::FindDynamicComponent(SearchActor, Value);
+			break;
 		case EBlueprintComponentReferenceMode::None:
 		default:
 			break;
@@ -126,6 +320,7 @@ void FBlueprintComponentReference::Invalidate()
 {
 	Mode = EBlueprintComponentReferenceMode::None;
 	Value = NAME_None;
+	MarkChanged();
 }
 
 bool FBlueprintComponentReference::SerializeFromMismatchedTag(const FPropertyTag& Tag, FStructuredArchive::FSlot Slot)
@@ -161,6 +356,7 @@ bool FBlueprintComponentReference::SerializeFromMismatchedTag(const FPropertyTag
 			Mode = EBlueprintComponentReferenceMode::Property;
 			Value = RootComponentReferencePropertyName;
 		}
+		MarkChanged();
 		return true;
 	}
 
@@ -186,9 +382,190 @@ bool FBlueprintComponentReference::SerializeFromMismatchedTag(const FPropertyTag
 			Mode = EBlueprintComponentReferenceMode::Property;
 			Value = RootComponentReferencePropertyName;
 		}
+		MarkChanged();
 		return true;
 	}
 #endif
 
 	return false;
 }
+
+namespace BCRNet
+{
+	// number of bits used to send reference mode
+	constexpr uint32 ModeBits = 3;
+	constexpr uint8 MaxMode = (1 << ModeBits) - 1;
+
+	static_assert(static_cast<uint8>(EBlueprintComponentReferenceMode::Dynamic) <= MaxMode, "Reference mode does not fit into network representation");
+}
+
+bool FBlueprintComponentReference::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(FBlueprintComponentReferenceVersion::GUID);
+
+	if (Ar.IsTextFormat()
+		|| Ar.IsSaveGame()
+		|| Ar.CustomVer(FBlueprintComponentReferenceVersion::GUID) < FBlueprintComponentReferenceVersion::CompactSerialization)
+	{
+		return false;
+	}
+
+	uint8 ModeValue = static_cast<uint8>(Mode);
+	Ar << ModeValue;
+	Ar << Value;
+
+	if (Ar.IsLoading())
+	{
+		Mode = ModeValue <= static_cast<uint8>(EBlueprintComponentReferenceMode::Dynamic)
+			? static_cast<EBlueprintComponentReferenceMode>(ModeValue)
+			: EBlueprintComponentReferenceMode::None;
+	}
+
+	return true;
+}
+
+bool FBlueprintComponentReference::ExportTextItem(FString& ValueStr, const FBlueprintComponentReference& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const
+{
+	const TCHAR* Prefix = nullptr;
+	switch (Mode)
+	{
+	case EBlueprintComponentReferenceMode::Property:
+		Prefix = TEXT("property:");
+		break;
+	case EBlueprintComponentReferenceMode::Path:
+		Prefix = TEXT("path:");
+		break;
+	case EBlueprintComponentReferenceMode::Nested:
+		Prefix = TEXT("nested:");
+		break;
+	case EBlueprintComponentReferenceMode::Dynamic:
+		Prefix = TEXT("dynamic:");
+		break;
+	default:
+		break;
+	}
+
+	if (!Prefix || Value.IsNone())
+	{
+		// let generic export handle null and malformed references
+		return false;
+	}
+
+	const bool bQuote = BCRText::NeedsQuotes(Value);
+	if (bQuote)
+	{
+		ValueStr += TEXT('"');
+	}
+	ValueStr += Prefix;
+	Value.AppendString(ValueStr);
+	if (bQuote)
+	{
+		ValueStr += TEXT('"');
+	}
+	return true;
+}
+
+bool FBlueprintComponentReference::ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText)
+{
+	// taken before generic import of members as well
+	MarkChanged();
+
+	const TCHAR* Cursor = Buffer;
+	while (FChar::IsWhitespace(*Cursor))
+	{
+		++Cursor;
+	}
+
+	if (*Cursor == TEXT('('))
+	{
+		// struct form, handled by generic import
+		return false;
+	}
+
+	const TCHAR* TokenStart;
+	int32 TokenLen;
+	if (*Cursor == TEXT('"'))
+	{
+		TokenStart = ++Cursor;
+		while (*Cursor && *Cursor != TEXT('"'))
+		{
+			++Cursor;
+		}
+		if (*Cursor != TEXT('"'))
+		{
+			return false;
+		}
+		TokenLen = UE_PTRDIFF_TO_INT32(Cursor - TokenStart);
+		++Cursor;
+	}
+	else
+	{
+		TokenStart = Cursor;
+		while (*Cursor && *Cursor != TEXT(',') && *Cursor != TEXT(')'))
+		{
+			++Cursor;
+		}
+		TokenLen = UE_PTRDIFF_TO_INT32(Cursor - TokenStart);
+	}
+
+	EBlueprintComponentReferenceMode ParsedMode;
+	FName ParsedValue;
+	if (!BCRText::ParseToken(TokenStart, TokenLen, ParsedMode, ParsedValue))
+	{
+		return false;
+	}
+
+	Mode = ParsedMode;
+	Value = ParsedValue;
+	Buffer = Cursor;
+	return true;
+}
+
+bool FBlueprintComponentReference::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 PackedMode = static_cast<uint8>(Mode);
+	Ar.SerializeBits(&PackedMode, BCRNet::ModeBits);
+
+	if (Ar.IsLoading())
+	{
+		MarkChanged();
+
+		if (PackedMode > static_cast<uint8>(EBlueprintComponentReferenceMode::Dynamic))
+		{
+			// unused mode values never come from a valid writer, value that may follow can not be trusted either
+			Mode = EBlueprintComponentReferenceMode::None;
+			Value = NAME_None;
+			bOutSuccess = false;
+			return true;
+		}
+
+		Mode = static_cast<EBlueprintComponentReferenceMode>(PackedMode);
+		if (Mode == EBlueprintComponentReferenceMode::None)
+		{
+			Value = NAME_None;
+		}
+	}
+
+	if (Mode != EBlueprintComponentReferenceMode::None)
+	{
+		if (Map)
+		{
+			Map->SerializeName(Ar, Value);
+		}
+		else
+		{
+			UPackageMap::StaticSerializeName(Ar, Value);
+		}
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+void FBlueprintComponentReference::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading())
+	{
+		MarkChanged();
+	}
+}
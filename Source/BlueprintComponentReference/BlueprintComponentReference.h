@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Containers/StringFwd.h"
 #include "UObject/SoftObjectPtr.h"
 #include "Components/ActorComponent.h"
 #include "BlueprintComponentReference.generated.h"
@@ -23,7 +24,16 @@ enum class EBlueprintComponentReferenceMode : uint8
 	/**
 	 * Referencing via object path
 	 */
-	Path UMETA(DisplayName="Object Path")
+	Path UMETA(DisplayName="Object Path"),
+	/**
+	 * Referencing via chain of child actor components, "Child.Sub.Component".
+	 * Each segment is a property name or object name, every segment but last must be a child actor component.
+	 */
+	Nested UMETA(DisplayName="Nested Path"),
+	/**
+	 * Referencing via selection of first component with tag or of class, "Tag:Name" or "Class:/Script/Module.ClassName"
+	 */
+	Dynamic UMETA(DisplayName="Dynamic Selection")
 };
 
 /**
@@ -126,9 +136,11 @@ public:
 	 * Set reference value from string.
 	 * Value may be represented as a pair "mode:value" or "value"
 	 *
+	 * Does not allocate unless value is a new name.
+	 *
 	 * @param InValue string
 	 */
-	bool ParseString(const FString& InValue);
+	bool ParseString(FStringView InValue);
 
 	/**
 	 * Get reference value as string
@@ -138,6 +150,13 @@ public:
 	 */
 	FString ToString() const;
 
+	/**
+	 * Append reference value as string to builder, in same form as ToString
+	 *
+	 * @param Out builder to append to
+	 */
+	void AppendString(FStringBuilderBase& Out) const;
+
 	/**
 	 * Get current component selection mode
 	 */
@@ -194,6 +213,16 @@ public:
 		return Cast<T>(GetComponent(SearchActor));
 	}
 
+	/**
+	 * Get value revision: a new one is taken each time mode or value are written by anything but a copy,
+	 * copies carry revision of their source. Equal revisions always mean equal values, so cached helpers
+	 * compare it instead of the whole value. Reference that was never set has revision 0.
+	 */
+	uint32 GetRevision() const
+	{
+		return Revision;
+	}
+
 	/**
 	 * Does this reference have any value set
 	 */
@@ -209,6 +238,36 @@ public:
 	 */
 	bool SerializeFromMismatchedTag(const FPropertyTag& Tag, FStructuredArchive::FSlot Slot);
 
+	/**
+	 * Binary serialization: mode and name are saved without property tags.
+	 * Data saved before FBlueprintComponentReferenceVersion::CompactSerialization, text and save game archives use tagged serialization.
+	 */
+	bool Serialize(FArchive& Ar);
+
+	/**
+	 * Export reference in compact "mode:value" form, null reference is left to generic export
+	 */
+	bool ExportTextItem(FString& ValueStr, const FBlueprintComponentReference& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const;
+
+	/**
+	 * Import reference from compact "mode:value" form, struct form "(Mode=...,Value=...)" is left to generic import
+	 */
+	bool ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText);
+
+	/**
+	 * Compact network serialization: mode is packed into 3 bits, value is sent through package map name table
+	 * and omitted when mode is not set. Unknown mode values are rejected and reset reference to None.
+	 *
+	 * Value is always sent as a name: reference struct does not know owning actor, so there is no class both sides
+	 * could agree on to send value as an index into its component table.
+	 */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	/**
+	 * Take new revision after any load, including tagged serialization of members
+	 */
+	void PostSerialize(const FArchive& Ar);
+
 	bool operator==(const FBlueprintComponentReference& Rhs) const
 	{
 		return Mode == Rhs.Mode && Value == Rhs.Value;
@@ -234,9 +293,27 @@ public:
 		return FBlueprintComponentReference(EBlueprintComponentReferenceMode::Path, InPath);
 	}
 
+	static FBlueprintComponentReference ForNested(const FName& InPath)
+	{
+		return FBlueprintComponentReference(EBlueprintComponentReferenceMode::Nested, InPath);
+	}
+
+	/**
+	 * Construct Dynamic mode reference selecting first component with tag
+	 */
+	static FBlueprintComponentReference ForTag(const FName& InTag);
+
+	/**
+	 * Construct Dynamic mode reference selecting first component of class
+	 */
+	static FBlueprintComponentReference ForClass(const UClass* InClass);
+
 protected:
 	UActorComponent* ExtractComponent(AActor* SearchActor) const;
 
+	/** Take new value revision, called by every write that is not a copy */
+	void MarkChanged();
+
 	friend class FBlueprintComponentReferenceHelper;
 
 	UPROPERTY(EditAnywhere, Category=Component)
@@ -244,6 +321,9 @@ protected:
 
 	UPROPERTY(EditAnywhere, Category=Component)
 	FName Value;
+
+	// not a property, see GetRevision
+	uint32 Revision = 0;
 };
 
 template<>
@@ -253,6 +333,11 @@ struct TStructOpsTypeTraits<FBlueprintComponentReference>
 	enum
 	{
 		WithIdenticalViaEquality = true,
-		WithStructuredSerializeFromMismatchedTag = true
+		WithSerializer = true,
+		WithStructuredSerializeFromMismatchedTag = true,
+		WithNetSerializer = true,
+		WithPostSerialize = true,
+		WithExportTextItem = true,
+		WithImportTextItem = true
 	};
 };
@@ -0,0 +1,180 @@
+// Copyright 2024, Aquanox.
+
+#include "BlueprintComponentReferenceArray.h"
+#include "BlueprintComponentReferenceCache.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+
+void FBlueprintComponentReferenceArrayItem::PreReplicatedRemove(const FBlueprintComponentReferenceArray& InArraySerializer)
+{
+	InArraySerializer.ForgetReplicatedItem(*this);
+}
+
+void FBlueprintComponentReferenceArrayItem::PostReplicatedAdd(const FBlueprintComponentReferenceArray& InArraySerializer)
+{
+	InArraySerializer.ResolveReplicatedItem(*this);
+}
+
+void FBlueprintComponentReferenceArrayItem::PostReplicatedChange(const FBlueprintComponentReferenceArray& InArraySerializer)
+{
+	InArraySerializer.ResolveReplicatedItem(*this);
+}
+
+void FBlueprintComponentReferenceArray::SetOwner(AActor* InOwner)
+{
+	Owner = InOwner;
+	ResolvedItems.Reset();
+	ComponentIndices.Reset();
+	IndexGeneration = 0;
+}
+
+int32 FBlueprintComponentReferenceArray::Add(const FBlueprintComponentReference& InReference)
+{
+	const int32 Index = Items.Emplace(InReference);
+	MarkItemDirty(Items[Index]);
+	++Revision;
+	return Index;
+}
+
+void FBlueprintComponentReferenceArray::Set(int32 Index, const FBlueprintComponentReference& InReference)
+{
+	FBlueprintComponentReferenceArrayItem& Item = Items[Index];
+	Item.Reference = InReference;
+	MarkItemDirty(Item);
+	++Revision;
+}
+
+void FBlueprintComponentReferenceArray::RemoveAt(int32 Index)
+{
+	Items.RemoveAt(Index);
+	if (ResolvedItems.IsValidIndex(Index))
+	{
+		ResolvedItems.RemoveAt(Index);
+	}
+	MarkArrayDirty();
+	++Revision;
+}
+
+void FBlueprintComponentReferenceArray::Reset()
+{
+	Items.Reset();
+	ResolvedItems.Reset();
+	MarkArrayDirty();
+	++Revision;
+}
+
+UActorComponent* FBlueprintComponentReferenceArray::GetComponent(int32 Index) const
+{
+	if (!Items.IsValidIndex(Index))
+	{
+		return nullptr;
+	}
+
+	if (ResolvedItems.IsValidIndex(Index))
+	{
+		const FCachedEntry& Entry = ResolvedItems[Index];
+		if (Entry.IsValidFor(Owner.Get(), Items[Index].Reference) && Entry.Component.IsValid())
+		{
+			return Entry.Component.Get();
+		}
+	}
+
+	return ResolveItem(Index);
+}
+
+int32 FBlueprintComponentReferenceArray::IndexOfComponent(const UActorComponent* InComponent) const
+{
+	if (!InComponent)
+	{
+		return INDEX_NONE;
+	}
+
+	UpdateComponentIndices();
+	if (IndexGeneration != 0)
+	{
+		// hits are checked against entry, lookup may point to a component destroyed and replaced at same address
+		const int32* Found = ComponentIndices.Find(InComponent);
+		return Found && GetComponent(*Found) == InComponent ? *Found : INDEX_NONE;
+	}
+
+	// owner components can not be tracked outside of game thread
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		if (GetComponent(Index) == InComponent)
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void FBlueprintComponentReferenceArray::UpdateComponentIndices() const
+{
+	const AActor* const SearchActor = Owner.Get();
+	if (IndexGeneration != 0
+		&& IndexGeneration == IndexActorGeneration->Load()
+		&& IndexRevision == Revision
+		&& IndexActor == SearchActor)
+	{
+		return;
+	}
+
+	IndexActorGeneration = FBlueprintComponentReferenceCache::AcquireActorGeneration(SearchActor);
+	const uint32 Generation = IndexActorGeneration.IsValid() ? IndexActorGeneration->Load() : 0;
+	if (Generation == 0)
+	{
+		IndexGeneration = 0;
+		return;
+	}
+
+	ComponentIndices.Reset();
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		const UActorComponent* const Component = GetComponent(Index);
+		if (Component && !ComponentIndices.Contains(Component))
+		{
+			ComponentIndices.Add(Component, Index);
+		}
+	}
+
+	IndexActor = SearchActor;
+	IndexRevision = Revision;
+	IndexGeneration = Generation;
+}
+
+UActorComponent* FBlueprintComponentReferenceArray::ResolveItem(int32 Index) const
+{
+	if (ResolvedItems.Num() < Items.Num())
+	{
+		ResolvedItems.SetNum(Items.Num());
+	}
+
+	AActor* const SearchActor = Owner.Get();
+	const FBlueprintComponentReference& Reference = Items[Index].Reference;
+	UActorComponent* const Component = Reference.GetComponent(SearchActor);
+	ResolvedItems[Index].Set(Component, SearchActor, Reference);
+	return Component;
+}
+
+void FBlueprintComponentReferenceArray::ResolveReplicatedItem(const FBlueprintComponentReferenceArrayItem& InItem) const
+{
+	++Revision;
+
+	const int32 Index = static_cast<int32>(&InItem - Items.GetData());
+	if (Items.IsValidIndex(Index))
+	{
+		ResolveItem(Index);
+	}
+}
+
+void FBlueprintComponentReferenceArray::ForgetReplicatedItem(const FBlueprintComponentReferenceArrayItem& InItem) const
+{
+	++Revision;
+
+	// replication removes entries after callbacks, remaining slots are rechecked against their entries on access
+	const int32 Index = static_cast<int32>(&InItem - Items.GetData());
+	if (ResolvedItems.IsValidIndex(Index))
+	{
+		ResolvedItems[Index].Reset();
+	}
+}
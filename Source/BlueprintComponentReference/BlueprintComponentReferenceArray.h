@@ -0,0 +1,189 @@
+// Copyright 2024, Aquanox.
+
+#pragma once
+
+#include "BlueprintComponentReference.h"
+#include "CachedBlueprintComponentReference.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+#include "Engine/NetSerialization.h"
+#else
+#include "Net/Serialization/FastArraySerializer.h"
+#endif
+#include "BlueprintComponentReferenceArray.generated.h"
+
+struct FBlueprintComponentReferenceArray;
+
+/**
+ * Single replicated entry of FBlueprintComponentReferenceArray
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTCOMPONENTREFERENCE_API FBlueprintComponentReferenceArrayItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+public:
+	FBlueprintComponentReferenceArrayItem() = default;
+
+	explicit FBlueprintComponentReferenceArrayItem(const FBlueprintComponentReference& InReference)
+		: Reference(InReference)
+	{
+	}
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Component)
+	FBlueprintComponentReference Reference;
+
+	void PreReplicatedRemove(const FBlueprintComponentReferenceArray& InArraySerializer);
+	void PostReplicatedAdd(const FBlueprintComponentReferenceArray& InArraySerializer);
+	void PostReplicatedChange(const FBlueprintComponentReferenceArray& InArraySerializer);
+};
+
+/**
+ * Delta replicated array of component references.
+ *
+ * Only added, changed and removed entries are sent. Resolved components are cached per entry and
+ * updated by replication callbacks on clients, owner actor must be set with SetOwner to resolve components.
+ *
+ * @code
+ * UCLASS()
+ * class AMyActorClass : public AActor
+ * {
+ *	   GENERATED_BODY()
+ *	public:
+ *     AMyActorClass() { WeakSpots.SetOwner(this); }
+ *
+ *     UPROPERTY(Replicated, EditDefaultsOnly)
+ *     FBlueprintComponentReferenceArray WeakSpots;
+ * };
+ *
+ * USceneComponent* Target = WeakSpots.GetComponent<USceneComponent>(0);
+ * @endcode
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTCOMPONENTREFERENCE_API FBlueprintComponentReferenceArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+public:
+	/**
+	 * Set actor that references are resolved in
+	 */
+	void SetOwner(AActor* InOwner);
+
+	/**
+	 * Get actor that references are resolved in
+	 */
+	AActor* GetOwner() const
+	{
+		return Owner.Get();
+	}
+
+	/**
+	 * Add reference to array and mark it for replication
+	 *
+	 * @return index of added entry
+	 */
+	int32 Add(const FBlueprintComponentReference& InReference);
+
+	/**
+	 * Replace reference at index and mark it for replication
+	 */
+	void Set(int32 Index, const FBlueprintComponentReference& InReference);
+
+	/**
+	 * Remove reference at index
+	 */
+	void RemoveAt(int32 Index);
+
+	/**
+	 * Remove all references
+	 */
+	void Reset();
+
+	int32 Num() const
+	{
+		return Items.Num();
+	}
+
+	bool IsEmpty() const
+	{
+		return Items.Num() == 0;
+	}
+
+	const FBlueprintComponentReference& GetReference(int32 Index) const
+	{
+		return Items[Index].Reference;
+	}
+
+	const TArray<FBlueprintComponentReferenceArrayItem>& GetItems() const
+	{
+		return Items;
+	}
+
+	/**
+	 * Get component referenced by entry at index, resolved in owner actor
+	 */
+	UActorComponent* GetComponent(int32 Index) const;
+
+	/**
+	 * Get component referenced by entry at index, resolved in owner actor
+	 */
+	template<typename T>
+	T* GetComponent(int32 Index) const
+	{
+		return Cast<T>(GetComponent(Index));
+	}
+
+	/**
+	 * Find index of entry that references component.
+	 *
+	 * Uses lookup built on first call that stays valid while entries and owner components do not change.
+	 *
+	 * @return index or INDEX_NONE
+	 */
+	int32 IndexOfComponent(const UActorComponent* InComponent) const;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FBlueprintComponentReferenceArrayItem, FBlueprintComponentReferenceArray>(Items, DeltaParms, *this);
+	}
+
+private:
+	friend struct FBlueprintComponentReferenceArrayItem;
+
+	using FCachedEntry = BCRDetails::TCachedEntry<TWeakObjectPtr<UActorComponent>>;
+
+	/** Resolve entry at index and store result in cache */
+	UActorComponent* ResolveItem(int32 Index) const;
+	/** Resolve entry received by replication */
+	void ResolveReplicatedItem(const FBlueprintComponentReferenceArrayItem& InItem) const;
+	/** Drop cached result of entry removed by replication */
+	void ForgetReplicatedItem(const FBlueprintComponentReferenceArrayItem& InItem) const;
+	/** Rebuild component to index lookup if entries or owner components changed */
+	void UpdateComponentIndices() const;
+
+	UPROPERTY(EditAnywhere, Category=Component)
+	TArray<FBlueprintComponentReferenceArrayItem> Items;
+
+	// actor to resolve references in
+	TWeakObjectPtr<AActor> Owner;
+	// resolved component per entry index, entries check source reference revision so stale slots after removal are not trusted
+	mutable TArray<FCachedEntry> ResolvedItems;
+	// changed by every modification of entries, local or replicated
+	mutable uint32 Revision = 0;
+	// resolved component to index of first entry referencing it
+	mutable TMap<const UActorComponent*, int32> ComponentIndices;
+	// state lookup was built for
+	mutable const AActor* IndexActor = nullptr;
+	mutable uint32 IndexRevision = 0;
+	mutable FActorGenerationRef IndexActorGeneration;
+	mutable uint32 IndexGeneration = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FBlueprintComponentReferenceArray>
+	: TStructOpsTypeTraitsBase2<FBlueprintComponentReferenceArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true
+	};
+};
@@ -0,0 +1,912 @@
+// Copyright 2024, Aquanox.
+
+#include "BlueprintComponentReferenceCache.h"
+#include "BlueprintComponentReference.h"
+#include "ComponentReferenceSchema.h"
+#include "Components/ActorComponent.h"
+#include "Components/ChildActorComponent.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "Misc/StringBuilder.h"
+#include "Containers/StringView.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/Class.h"
+#include "UObject/UObjectArray.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+namespace BCRCache
+{
+	/** Plans of every object property of one class, built at once on first lookup in class */
+	struct FClassPlans
+	{
+		TMap<FName, FComponentReferencePlan> Plans;
+	};
+	using FPlanTable = TMap<TObjectKey<UClass>, const FClassPlans*>;
+
+	/**
+	 * Plans are published as immutable snapshots, readers load current snapshot pointer and never lock.
+	 *
+	 * Snapshot is sharded by class: a miss builds plans for all object properties of the class in one go
+	 * and publishes them with a single copy of class to plans table, which only holds pointers,
+	 * so filling the cache costs one publication per class instead of one full table copy per property.
+	 *
+	 * Replaced tables and class plans may still be read by lookups in flight, they are retired and
+	 * deleted after next garbage collection, so lookups must not span garbage collection.
+	 */
+	static std::atomic<const FPlanTable*> PublishedPlans { nullptr };
+	// serializes writers, guards ownership of current and retired snapshots
+	static FCriticalSection PlanWriteLock;
+	static TUniquePtr<FPlanTable> CurrentPlans;
+	static TMap<TObjectKey<UClass>, TUniquePtr<FClassPlans>> CurrentClassPlans;
+	static TArray<TUniquePtr<FPlanTable>> RetiredPlans;
+	static TArray<TUniquePtr<FClassPlans>> RetiredClassPlans;
+	static std::atomic<uint32> Generation { 1 };
+	// records replaced by concurrent cached references, deleted after garbage collection like plan snapshots
+	static FCriticalSection RecordLock;
+	static TArray<TUniquePtr<const FPublishedComponentRecord>> RetiredRecords;
+	// source of per-actor component generations, game thread only
+	static uint32 NextActorGeneration = 1;
+
+	/** Replace current snapshot, requires PlanWriteLock */
+	inline void PublishPlans(TUniquePtr<FPlanTable>&& InPlans)
+	{
+		PublishedPlans.store(InPlans.Get(), std::memory_order_release);
+		if (CurrentPlans.IsValid())
+		{
+			RetiredPlans.Add(MoveTemp(CurrentPlans));
+		}
+		CurrentPlans = MoveTemp(InPlans);
+	}
+
+	/** Take ownership of class plans that are no longer published, requires PlanWriteLock */
+	inline void RetireClassPlans(const TObjectKey<UClass>& InClass)
+	{
+		TUniquePtr<FClassPlans> Retired;
+		if (CurrentClassPlans.RemoveAndCopyValue(InClass, Retired) && Retired.IsValid())
+		{
+			RetiredClassPlans.Add(MoveTemp(Retired));
+		}
+	}
+
+	inline FComponentReferencePlan MakePlan(const FObjectPropertyBase* InProperty)
+	{
+		FComponentReferencePlan Plan;
+		Plan.Property = InProperty;
+		Plan.Offset = InProperty->GetOffset_ForInternal();
+		// weak, lazy and soft references have own storage layout and must be read via property
+		Plan.bDirectAccess = InProperty->IsA<FObjectProperty>();
+		return Plan;
+	}
+
+	/** Collect plans of every object property of class, derived properties hide same named ones of super classes */
+	inline TUniquePtr<FClassPlans> BuildClassPlans(const UClass* InClass)
+	{
+		TUniquePtr<FClassPlans> Result = MakeUnique<FClassPlans>();
+		for (TFieldIterator<FObjectPropertyBase> It(InClass, EFieldIteratorFlags::IncludeSuper); It; ++It)
+		{
+			if (!Result->Plans.Contains(It->GetFName()))
+			{
+				Result->Plans.Add(It->GetFName(), MakePlan(*It));
+			}
+		}
+		Result->Plans.Compact();
+		return Result;
+	}
+
+	static TAutoConsoleVariable<bool> CVarUseComponentNameIndex(
+		TEXT("BCR.UseComponentNameIndex"),
+		true,
+		TEXT("Use per-actor component name index to resolve Path mode references"));
+
+	static TAutoConsoleVariable<bool> CVarUseComponentSelectorIndex(
+		TEXT("BCR.UseComponentSelectorIndex"),
+		true,
+		TEXT("Use per-actor component tag and class indices to resolve Dynamic mode references"));
+
+	/**
+	 * Cached per-actor data: component generation and lookups of owned components.
+	 *
+	 * Generation is taken from global counter, so it is never repeated for another actor or state.
+	 * Owned components count and plan cache generation are checked on each access,
+	 * creation of a component in actor marks state dirty eagerly (see FComponentCreateListener).
+	 *
+	 * Current generation is mirrored into a shared slot held by cached reference helpers,
+	 * slot is zeroed whenever state is outdated or dropped so helpers never need to look actor up.
+	 */
+	struct FActorComponentIndex
+	{
+		// number of owned components when generation was started
+		int32 NumComponents = INDEX_NONE;
+		// plan cache generation when generation was started
+		uint32 CacheGeneration = 0;
+		// component generation of actor
+		uint32 ComponentGeneration = 0;
+		// generation shared with cached reference helpers
+		TSharedRef<FActorGenerationSlot, ESPMode::ThreadSafe> Slot = MakeShared<FActorGenerationSlot, ESPMode::ThreadSafe>();
+		// actor is listed in DirtyActors
+		bool bListedDirty = false;
+		// direct subobject components by name, built on first Path mode lookup
+		bool bHasNames = false;
+		TMap<FName, TWeakObjectPtr<UActorComponent>> ByName;
+		// first component with tag, built on first Dynamic mode lookup by tag
+		bool bHasTags = false;
+		TMap<FName, TWeakObjectPtr<UActorComponent>> ByTag;
+		// first component of class, filled for each queried class, null if actor has none
+		TMap<TObjectKey<UClass>, TWeakObjectPtr<UActorComponent>> ByClass;
+
+		bool IsUpToDate(const AActor* InActor) const
+		{
+			return NumComponents == InActor->GetComponents().Num()
+				&& CacheGeneration == Generation.load(std::memory_order_relaxed);
+		}
+
+		/** Start new component generation, lookups are rebuilt on demand */
+		void Bump(const AActor* InActor)
+		{
+			NumComponents = InActor->GetComponents().Num();
+			CacheGeneration = Generation.load(std::memory_order_relaxed);
+			ComponentGeneration = NextActorGeneration++;
+			if (NextActorGeneration == 0)
+			{ // zero is never a valid generation
+				NextActorGeneration = 1;
+			}
+			Slot->Value.store(ComponentGeneration, std::memory_order_release);
+
+			bHasNames = false;
+			ByName.Reset();
+			bHasTags = false;
+			ByTag.Reset();
+			ByClass.Reset();
+		}
+
+		/** Outdate state without touching actor, next access starts new generation */
+		void MarkDirty()
+		{
+			NumComponents = INDEX_NONE;
+			Slot->Value.store(0, std::memory_order_release);
+		}
+
+		/** Called before state is dropped, helpers still holding slot acquire a new one */
+		void Detach()
+		{
+			Slot->Value.store(0, std::memory_order_release);
+		}
+
+		void BuildNames(const AActor* InActor)
+		{
+			bHasNames = true;
+			for (UActorComponent* Component : InActor->GetComponents())
+			{
+				// path references are names of direct subobjects
+				if (Component && Component->GetOuter() == InActor)
+				{
+					ByName.Add(Component->GetFName(), Component);
+				}
+			}
+		}
+
+		void BuildTags(const AActor* InActor)
+		{
+			bHasTags = true;
+			for (UActorComponent* Component : InActor->GetComponents())
+			{
+				if (Component)
+				{
+					for (const FName& Tag : Component->ComponentTags)
+					{
+						if (!ByTag.Contains(Tag))
+						{
+							ByTag.Add(Tag, Component);
+						}
+					}
+				}
+			}
+		}
+	};
+
+	// accessed only from game thread
+	static TMap<TObjectKey<AActor>, FActorComponentIndex> ActorIndices;
+
+	/** Get index of actor, new generation is started if set of owned components changed, game thread only */
+	inline FActorComponentIndex& GetActorIndex(const AActor* InActor)
+	{
+		FActorComponentIndex& Index = ActorIndices.FindOrAdd(InActor);
+		if (!Index.IsUpToDate(InActor))
+		{
+			Index.Bump(InActor);
+		}
+		return Index;
+	}
+
+	// actors which state was marked dirty by created component, drained by TakeDirtyActors, game thread only
+	static TArray<TObjectKey<AActor>> DirtyActors;
+
+	/**
+	 * Marks state of actor dirty when a component is created in it.
+	 *
+	 * Runs inside object allocation, so it only flips state of actors that already have one and lists them,
+	 * anything else is done by whoever drains the list. Destroyed components leave owned components set at once
+	 * and are detected by count, a created one is caught here so remove and add within a frame is not missed.
+	 */
+	class FComponentCreateListener : public FUObjectArray::FUObjectCreateListener
+	{
+	public:
+		virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override
+		{
+			// components of actors used by references are created on game thread
+			if (ActorIndices.Num() == 0 || !IsInGameThread())
+			{
+				return;
+			}
+
+			const UObject* Created = static_cast<const UObject*>(Object);
+			if (Created->GetClass()->IsChildOf(UActorComponent::StaticClass()))
+			{
+				const AActor* Owner = Created->GetTypedOuter<AActor>();
+				FActorComponentIndex* State = Owner ? ActorIndices.Find(Owner) : nullptr;
+				if (State)
+				{ // not yet in owned components, start new generation on next access
+					State->MarkDirty();
+					if (!State->bListedDirty)
+					{
+						State->bListedDirty = true;
+						DirtyActors.Add(Owner);
+					}
+				}
+			}
+		}
+
+		virtual void OnUObjectArrayShutdown() override
+		{
+			GUObjectArray.RemoveUObjectCreateListener(this);
+			bRegistered = false;
+		}
+
+		bool bRegistered = false;
+	};
+
+	static FComponentCreateListener CreateListener;
+
+	inline UActorComponent* ScanComponents(const AActor* InActor, TFunctionRef<bool(const UActorComponent*)> Predicate)
+	{
+		for (UActorComponent* Component : InActor->GetComponents())
+		{
+			if (Component && Predicate(Component))
+			{
+				return Component;
+			}
+		}
+		return nullptr;
+	}
+
+	// parsed Dynamic mode selectors, dropped with plans as selected classes may be reinstanced
+	static FRWLock SelectorLock;
+	static TMap<FName, FComponentReferenceSelector> Selectors;
+
+	// split nested paths, path text does not depend on classes so entries are kept across resets
+	static FRWLock SegmentLock;
+	static TMap<FName, TUniquePtr<TArray<FName>>> PathSegments;
+
+	/**
+	 * Find component template of class by object name: default subobject of class default object
+	 * or construction script node of class or any of its super classes.
+	 */
+	inline const UActorComponent* FindTemplateByName(const UClass* InClass, FName InName)
+	{
+		if (UObject* DefaultObject = InClass->GetDefaultObject(false))
+		{
+			if (const UActorComponent* Component = FindObjectFast<UActorComponent>(DefaultObject, InName))
+			{
+				return Component;
+			}
+		}
+
+		for (const UClass* Class = InClass; Class; Class = Class->GetSuperClass())
+		{
+			const UBlueprintGeneratedClass* GeneratedClass = Cast<UBlueprintGeneratedClass>(Class);
+			const USCS_Node* Node = GeneratedClass && GeneratedClass->SimpleConstructionScript
+				? GeneratedClass->SimpleConstructionScript->FindSCSNode(InName)
+				: nullptr;
+			if (Node && Node->ComponentTemplate)
+			{
+				return Node->ComponentTemplate;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/** Can segment of Property or Path mode be resolved in class: component property or component template name */
+	inline bool HasComponent(const UClass* InClass, FName InName)
+	{
+		const FComponentReferencePlan Plan = FBlueprintComponentReferenceCache::FindPlan(InClass, InName);
+		if (Plan.IsValid() && Plan.Property->PropertyClass && Plan.Property->PropertyClass->IsChildOf(UActorComponent::StaticClass()))
+		{
+			return true;
+		}
+		return FindTemplateByName(InClass, InName) != nullptr;
+	}
+
+	/** Find component template of class by property value in class defaults, then by name */
+	inline const UActorComponent* FindTemplate(const UClass* InClass, FName InName)
+	{
+		const FComponentReferencePlan Plan = FBlueprintComponentReferenceCache::FindPlan(InClass, InName);
+		UObject* DefaultObject = InClass->GetDefaultObject(false);
+		if (Plan.IsValid() && DefaultObject)
+		{
+			if (const UActorComponent* Component = Cast<UActorComponent>(Plan.Resolve(DefaultObject)))
+			{
+				return Component;
+			}
+		}
+		// construction script components are not assigned in defaults, node is named after variable
+		return FindTemplateByName(InClass, InName);
+	}
+
+#if WITH_EDITOR
+	/**
+	 * Blueprint recompilation reuses class object and moves old properties to a transient class,
+	 * so a plan taken before recompilation is no longer valid for the class it was built for.
+	 */
+	inline bool IsPlanUpToDate(const UClass* InClass, const FComponentReferencePlan& InPlan)
+	{
+		return !InPlan.IsValid() || InClass->IsChildOf(InPlan.Property->GetOwnerClass());
+	}
+#endif
+}
+
+FComponentReferencePlan FBlueprintComponentReferenceCache::FindPlan(const UClass* InClass, FName InName)
+{
+	if (!InClass || InName.IsNone())
+	{
+		return FComponentReferencePlan();
+	}
+
+	const TObjectKey<UClass> ClassKey(InClass);
+
+	if (const BCRCache::FPlanTable* Snapshot = BCRCache::PublishedPlans.load(std::memory_order_acquire))
+	{
+		if (const BCRCache::FClassPlans* const* ClassPlans = Snapshot->Find(ClassKey))
+		{
+			// class plans are complete, missing name is not an object property of class
+			const FComponentReferencePlan* Existing = (*ClassPlans)->Plans.Find(InName);
+#if WITH_EDITOR
+			if (!Existing || BCRCache::IsPlanUpToDate(InClass, *Existing))
+#endif
+			{
+				return Existing ? *Existing : FComponentReferencePlan();
+			}
+		}
+	}
+
+	TUniquePtr<BCRCache::FClassPlans> Built = BCRCache::BuildClassPlans(InClass);
+	const FComponentReferencePlan* Found = Built->Plans.Find(InName);
+	const FComponentReferencePlan Plan = Found ? *Found : FComponentReferencePlan();
+
+	{
+		FScopeLock WriteLock(&BCRCache::PlanWriteLock);
+
+		if (BCRCache::CurrentPlans.IsValid())
+		{
+			const BCRCache::FClassPlans* const* Existing = BCRCache::CurrentPlans->Find(ClassKey);
+			const FComponentReferencePlan* ExistingPlan = Existing ? (*Existing)->Plans.Find(InName) : nullptr;
+			if (Existing && (ExistingPlan ? ExistingPlan->Property : nullptr) == Plan.Property)
+			{ // published by another thread meanwhile
+				return Plan;
+			}
+		}
+
+		TUniquePtr<BCRCache::FPlanTable> Updated = BCRCache::CurrentPlans.IsValid()
+			? MakeUnique<BCRCache::FPlanTable>(*BCRCache::CurrentPlans)
+			: MakeUnique<BCRCache::FPlanTable>();
+		Updated->Add(ClassKey, Built.Get());
+
+		BCRCache::RetireClassPlans(ClassKey);
+		BCRCache::CurrentClassPlans.Add(ClassKey, MoveTemp(Built));
+		BCRCache::PublishPlans(MoveTemp(Updated));
+	}
+
+	return Plan;
+}
+
+UActorComponent* FBlueprintComponentReferenceCache::FindComponentByName(const AActor* InActor, FName InName)
+{
+	if (!InActor || InName.IsNone())
+	{
+		return nullptr;
+	}
+
+	if (IsInGameThread() && BCRCache::CVarUseComponentNameIndex.GetValueOnGameThread())
+	{
+		BCRCache::FActorComponentIndex& Index = BCRCache::GetActorIndex(InActor);
+		if (!Index.bHasNames)
+		{
+			Index.BuildNames(InActor);
+		}
+
+		if (const TWeakObjectPtr<UActorComponent>* Found = Index.ByName.Find(InName))
+		{
+			UActorComponent* Component = Found->Get();
+			// component may have been renamed or moved since index was built
+			if (Component && Component->GetFName() == InName && Component->GetOuter() == InActor)
+			{
+				return Component;
+			}
+		}
+		// not an owned component, it still may be a subobject created in unusual way
+	}
+
+	return FindObjectFast<UActorComponent>(const_cast<AActor*>(InActor), InName);
+}
+
+UActorComponent* FBlueprintComponentReferenceCache::FindNestedComponent(const AActor* InActor, FName InPath)
+{
+	if (!InActor || InPath.IsNone())
+	{
+		return nullptr;
+	}
+
+	const TConstArrayView<FName> Segments = FindPathSegments(InPath);
+	if (Segments.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const AActor* Current = InActor;
+	for (int32 Index = 0; Index < Segments.Num() - 1; ++Index)
+	{
+		const UChildActorComponent* ChildComponent = Cast<UChildActorComponent>(FindComponentBySegment(Current, Segments[Index]));
+		Current = ChildComponent ? ChildComponent->GetChildActor() : nullptr;
+		if (!Current)
+		{
+			return nullptr;
+		}
+	}
+
+	return FindComponentBySegment(Current, Segments.Last());
+}
+
+UActorComponent* FBlueprintComponentReferenceCache::FindComponentBySegment(const AActor* InActor, FName InSegment)
+{
+	const FComponentReferencePlan Plan = FindPlan(InActor->GetClass(), InSegment);
+	if (Plan.IsValid())
+	{
+		return Cast<UActorComponent>(Plan.Resolve(InActor));
+	}
+	return FindComponentByName(InActor, InSegment);
+}
+
+TConstArrayView<FName> FBlueprintComponentReferenceCache::FindPathSegments(FName InPath)
+{
+	{
+		FReadScopeLock ReadLock(BCRCache::SegmentLock);
+		if (const TUniquePtr<TArray<FName>>* Existing = BCRCache::PathSegments.Find(InPath))
+		{
+			return **Existing;
+		}
+	}
+
+	TArray<FString> Parts;
+	InPath.ToString().ParseIntoArray(Parts, TEXT("."), true);
+
+	TArray<FName> Segments;
+	Segments.Reserve(Parts.Num());
+	for (const FString& Part : Parts)
+	{
+		Segments.Add(FName(*Part.TrimStartAndEnd()));
+	}
+
+	FWriteScopeLock WriteLock(BCRCache::SegmentLock);
+	TUniquePtr<TArray<FName>>& Entry = BCRCache::PathSegments.FindOrAdd(InPath);
+	if (!Entry.IsValid())
+	{
+		Entry = MakeUnique<TArray<FName>>(MoveTemp(Segments));
+	}
+	return *Entry;
+}
+
+FComponentReferenceSelector FBlueprintComponentReferenceCache::FindSelector(FName InValue)
+{
+	{
+		FReadScopeLock ReadLock(BCRCache::SelectorLock);
+		if (const FComponentReferenceSelector* Existing = BCRCache::Selectors.Find(InValue))
+		{
+			if (Existing->Kind != FComponentReferenceSelector::EKind::Class || Existing->Class.IsValid())
+			{
+				return *Existing;
+			}
+		}
+	}
+
+	FComponentReferenceSelector Selector;
+
+	TStringBuilder<NAME_SIZE> Buffer;
+	InValue.AppendString(Buffer);
+	const FStringView Text(Buffer);
+
+	int32 Separator = INDEX_NONE;
+	if (Text.FindChar(TEXT(':'), Separator))
+	{
+		const FStringView Kind = Text.Left(Separator).TrimStartAndEnd();
+		const FStringView Argument = Text.Mid(Separator + 1).TrimStartAndEnd();
+
+		if (Kind.Equals(TEXT("tag"), ESearchCase::IgnoreCase) && !Argument.IsEmpty())
+		{
+			Selector.Kind = FComponentReferenceSelector::EKind::Tag;
+			Selector.Tag = FName(Argument.Len(), Argument.GetData());
+		}
+		else if (Kind.Equals(TEXT("class"), ESearchCase::IgnoreCase) && !Argument.IsEmpty())
+		{
+			UClass* Class = FindObject<UClass>(nullptr, *FString(Argument));
+			if (Class && Class->IsChildOf(UActorComponent::StaticClass()))
+			{
+				Selector.Kind = FComponentReferenceSelector::EKind::Class;
+				Selector.Class = Class;
+			}
+		}
+	}
+
+	// selected class may be loaded later, so only found classes are kept
+	if (Selector.Kind != FComponentReferenceSelector::EKind::Class || Selector.Class.IsValid())
+	{
+		FWriteScopeLock WriteLock(BCRCache::SelectorLock);
+		BCRCache::Selectors.Add(InValue, Selector);
+	}
+
+	return Selector;
+}
+
+UActorComponent* FBlueprintComponentReferenceCache::FindDynamicComponent(const AActor* InActor, FName InValue)
+{
+	if (!InActor || InValue.IsNone())
+	{
+		return nullptr;
+	}
+
+	const FComponentReferenceSelector Selector = FindSelector(InValue);
+	switch (Selector.Kind)
+	{
+	case FComponentReferenceSelector::EKind::Tag:
+		return FindComponentByTag(InActor, Selector.Tag);
+	case FComponentReferenceSelector::EKind::Class:
+		return FindComponentByClass(InActor, Selector.Class.Get());
+	default:
+		return nullptr;
+	}
+}
+
+UActorComponent* FBlueprintComponentReferenceCache::FindComponentByTag(const AActor* InActor, FName InTag)
+{
+	if (!InActor || InTag.IsNone())
+	{
+		return nullptr;
+	}
+
+	if (IsInGameThread() && BCRCache::CVarUseComponentSelectorIndex.GetValueOnGameThread())
+	{
+		BCRCache::FActorComponentIndex& Index = BCRCache::GetActorIndex(InActor);
+		if (!Index.bHasTags)
+		{
+			Index.BuildTags(InActor);
+		}
+
+		if (const TWeakObjectPtr<UActorComponent>* Found = Index.ByTag.Find(InTag))
+		{
+			UActorComponent* Component = Found->Get();
+			// tags may have been changed since index was built
+			if (Component && Component->GetOwner() == InActor && Component->ComponentHasTag(InTag))
+			{
+				return Component;
+			}
+		}
+
+		// misses are not remembered, tag may be added to existing component without any notification
+		UActorComponent* Selected = BCRCache::ScanComponents(InActor, [InTag](const UActorComponent* InComponent)
+		{
+			return InComponent->ComponentHasTag(InTag);
+		});
+		if (Selected)
+		{
+			Index.ByTag.Add(InTag, Selected);
+		}
+		return Selected;
+	}
+
+	return BCRCache::ScanComponents(InActor, [InTag](const UActorComponent* InComponent)
+	{
+		return InComponent->ComponentHasTag(InTag);
+	});
+}
+
+UActorComponent* FBlueprintComponentReferenceCache::FindComponentByClass(const AActor* InActor, const UClass* InClass)
+{
+	if (!InActor || !InClass)
+	{
+		return nullptr;
+	}
+
+	if (IsInGameThread() && BCRCache::CVarUseComponentSelectorIndex.GetValueOnGameThread())
+	{
+		BCRCache::FActorComponentIndex& Index = BCRCache::GetActorIndex(InActor);
+
+		if (const TWeakObjectPtr<UActorComponent>* Found = Index.ByClass.Find(InClass))
+		{
+			if (Found->IsExplicitlyNull())
+			{
+				return nullptr;
+			}
+
+			UActorComponent* Component = Found->Get();
+			if (Component && Component->GetOwner() == InActor)
+			{
+				return Component;
+			}
+		}
+
+		UActorComponent* Selected = BCRCache::ScanComponents(InActor, [InClass](const UActorComponent* InComponent)
+		{
+			return InComponent->IsA(InClass);
+		});
+		// miss is remembered as null: class of a component never changes and any created or
+		// destroyed component starts a new actor generation, which drops remembered results
+		Index.ByClass.Add(InClass, Selected);
+		return Selected;
+	}
+
+	return BCRCache::ScanComponents(InActor, [InClass](const UActorComponent* InComponent)
+	{
+		return InComponent->IsA(InClass);
+	});
+}
+
+void FBlueprintComponentReferenceCache::InvalidateActor(const AActor* InActor)
+{
+	check(IsInGameThread());
+	if (BCRCache::FActorComponentIndex* Index = BCRCache::ActorIndices.Find(InActor))
+	{ // slot is kept, helpers holding it see new generation
+		Index->Bump(InActor);
+	}
+}
+
+void FBlueprintComponentReferenceCache::ForgetActor(const AActor* InActor)
+{
+	check(IsInGameThread());
+	BCRCache::FActorComponentIndex Removed;
+	if (BCRCache::ActorIndices.RemoveAndCopyValue(InActor, Removed))
+	{
+		Removed.Detach();
+	}
+}
+
+uint32 FBlueprintComponentReferenceCache::GetActorGeneration(const AActor* InActor)
+{
+	if (!InActor || !IsInGameThread())
+	{
+		return 0;
+	}
+	const BCRCache::FActorComponentIndex* Index = BCRCache::ActorIndices.Find(InActor);
+	return Index && Index->IsUpToDate(InActor) ? Index->ComponentGeneration : 0;
+}
+
+FActorGenerationRef FBlueprintComponentReferenceCache::AcquireActorGeneration(const AActor* InActor)
+{
+	if (!InActor || !IsInGameThread())
+	{
+		return nullptr;
+	}
+	return BCRCache::GetActorIndex(InActor).Slot;
+}
+
+bool FBlueprintComponentReferenceCache::CanResolveInClass(const FBlueprintComponentReference& InReference, const UClass* InActorClass)
+{
+	if (!InActorClass || !InActorClass->IsChildOf(AActor::StaticClass()))
+	{
+		return false;
+	}
+
+	switch (InReference.GetMode())
+	{
+	case EBlueprintComponentReferenceMode::Property:
+	{
+		const FComponentReferencePlan Plan = FindPlan(InActorClass, InReference.GetValue());
+		return Plan.IsValid() && Plan.Property->PropertyClass && Plan.Property->PropertyClass->IsChildOf(UActorComponent::StaticClass());
+	}
+	case EBlueprintComponentReferenceMode::Path:
+		return BCRCache::FindTemplateByName(InActorClass, InReference.GetValue()) != nullptr;
+	case EBlueprintComponentReferenceMode::Nested:
+	{
+		const TConstArrayView<FName> Segments = FindPathSegments(InReference.GetValue());
+		if (Segments.Num() == 0)
+		{
+			return false;
+		}
+
+		const UClass* CurrentClass = InActorClass;
+		for (int32 Index = 0; Index < Segments.Num() - 1; ++Index)
+		{
+			const UChildActorComponent* ChildComponent = Cast<UChildActorComponent>(BCRCache::FindTemplate(CurrentClass, Segments[Index]));
+			if (!ChildComponent)
+			{
+				// child actor component property may be assigned at runtime, the rest of path is not known
+				const FComponentReferencePlan Plan = FindPlan(CurrentClass, Segments[Index]);
+				return Plan.IsValid() && Plan.Property->PropertyClass && Plan.Property->PropertyClass->IsChildOf(UChildActorComponent::StaticClass());
+			}
+
+			CurrentClass = ChildComponent->GetChildActorClass().Get();
+			if (!CurrentClass)
+			{ // child actor class is chosen at runtime, the rest of path is not known
+				return true;
+			}
+		}
+		return BCRCache::HasComponent(CurrentClass, Segments.Last());
+	}
+	case EBlueprintComponentReferenceMode::Dynamic:
+		// selected components may be added at runtime, only selector is checked
+		return FindSelector(InReference.GetValue()).IsValid();
+	case EBlueprintComponentReferenceMode::None:
+	default:
+		return false;
+	}
+}
+
+bool FBlueprintComponentReferenceCache::RefreshActor(const AActor* InActor)
+{
+	check(IsInGameThread());
+	BCRCache::FActorComponentIndex* Index = InActor ? BCRCache::ActorIndices.Find(InActor) : nullptr;
+	if (Index && !Index->IsUpToDate(InActor))
+	{
+		Index->Bump(InActor);
+		return true;
+	}
+	return false;
+}
+
+void FBlueprintComponentReferenceCache::TakeDirtyActors(const UWorld* InWorld, TArray<AActor*>& OutActors)
+{
+	check(IsInGameThread());
+	for (int32 Index = BCRCache::DirtyActors.Num() - 1; Index >= 0; --Index)
+	{
+		const TObjectKey<AActor>& Key = BCRCache::DirtyActors[Index];
+		AActor* Actor = Key.ResolveObjectPtr();
+		BCRCache::FActorComponentIndex* State = Actor ? BCRCache::ActorIndices.Find(Key) : nullptr;
+		if (State && Actor->GetWorld() != InWorld)
+		{ // left for subsystem of its world
+			continue;
+		}
+
+		if (State)
+		{
+			State->bListedDirty = false;
+			OutActors.Add(Actor);
+		}
+		BCRCache::DirtyActors.RemoveAtSwap(Index);
+	}
+}
+
+bool FBlueprintComponentReferenceCache::HasDirtyActors()
+{
+	return BCRCache::DirtyActors.Num() > 0;
+}
+
+void FBlueprintComponentReferenceCache::StartTracking()
+{
+	if (!BCRCache::CreateListener.bRegistered)
+	{
+		GUObjectArray.AddUObjectCreateListener(&BCRCache::CreateListener);
+		BCRCache::CreateListener.bRegistered = true;
+	}
+}
+
+void FBlueprintComponentReferenceCache::RetirePublishedRecord(const FPublishedComponentRecord* InRecord)
+{
+	if (InRecord)
+	{
+		// owners may be destroyed outside of game thread
+		FScopeLock Lock(&BCRCache::RecordLock);
+		BCRCache::RetiredRecords.Emplace(InRecord);
+	}
+}
+
+void FBlueprintComponentReferenceCache::StopTracking()
+{
+	if (BCRCache::CreateListener.bRegistered)
+	{
+		GUObjectArray.RemoveUObjectCreateListener(&BCRCache::CreateListener);
+		BCRCache::CreateListener.bRegistered = false;
+	}
+}
+
+void FBlueprintComponentReferenceCache::Reset()
+{
+	{
+		FScopeLock WriteLock(&BCRCache::PlanWriteLock);
+		BCRCache::PublishPlans(TUniquePtr<BCRCache::FPlanTable>());
+		for (auto& Pair : BCRCache::CurrentClassPlans)
+		{
+			BCRCache::RetiredClassPlans.Add(MoveTemp(Pair.Value));
+		}
+		BCRCache::CurrentClassPlans.Reset();
+		// actor states check it and start new generation
+		BCRCache::Generation.fetch_add(1, std::memory_order_release);
+	}
+
+	{
+		FWriteScopeLock WriteLock(BCRCache::SelectorLock);
+		BCRCache::Selectors.Reset();
+	}
+
+	if (IsInGameThread())
+	{
+		for (auto& Pair : BCRCache::ActorIndices)
+		{
+			Pair.Value.Detach();
+		}
+		BCRCache::ActorIndices.Reset();
+		BCRCache::DirtyActors.Reset();
+	}
+}
+
+uint32 FBlueprintComponentReferenceCache::GetGeneration()
+{
+	return BCRCache::Generation.load(std::memory_order_acquire);
+}
+
+void FBlueprintComponentReferenceCache::PruneStaleEntries()
+{
+	{
+		FScopeLock WriteLock(&BCRCache::PlanWriteLock);
+
+		// snapshots retired before this collection are no longer read by anyone
+		BCRCache::RetiredPlans.Reset();
+		BCRCache::RetiredClassPlans.Reset();
+
+		if (BCRCache::CurrentPlans.IsValid())
+		{
+			TUniquePtr<BCRCache::FPlanTable> Pruned;
+			for (const auto& Pair : *BCRCache::CurrentPlans)
+			{
+				if (Pair.Key.ResolveObjectPtr() == nullptr)
+				{
+					if (!Pruned.IsValid())
+					{
+						Pruned = MakeUnique<BCRCache::FPlanTable>(*BCRCache::CurrentPlans);
+					}
+					Pruned->Remove(Pair.Key);
+					BCRCache::RetireClassPlans(Pair.Key);
+				}
+			}
+
+			if (Pruned.IsValid())
+			{
+				BCRCache::PublishPlans(MoveTemp(Pruned));
+			}
+		}
+	}
+
+	{
+		FScopeLock Lock(&BCRCache::RecordLock);
+		BCRCache::RetiredRecords.Reset();
+	}
+
+	for (auto It = BCRCache::ActorIndices.CreateIterator(); It; ++It)
+	{
+		if (It->Key.ResolveObjectPtr() == nullptr)
+		{
+			It->Value.Detach();
+			It.RemoveCurrent();
+		}
+	}
+
+	BCRCache::DirtyActors.RemoveAllSwap([](const TObjectKey<AActor>& InKey)
+	{
+		return !BCRCache::ActorIndices.Contains(InKey);
+	});
+
+	FComponentReferenceSchema::PruneStaleEntries();
+}
@@ -0,0 +1,339 @@
+// Copyright 2024, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "Misc/EngineVersionComparison.h"
+#include <atomic>
+
+class UClass;
+class AActor;
+class UWorld;
+class UActorComponent;
+struct FBlueprintComponentReference;
+
+/**
+ * Resolution plan for a Property-mode reference within a specific class.
+ *
+ * Built once per (Class, Name) pair and reused by every subsequent resolve,
+ * so resolving a reference does not need to walk the class field chain.
+ */
+struct BLUEPRINTCOMPONENTREFERENCE_API FComponentReferencePlan
+{
+	/** Resolved property, null if class has no matching object property */
+	const FObjectPropertyBase* Property = nullptr;
+	/** Offset of property value within container */
+	int32 Offset = INDEX_NONE;
+	/** Is property a plain hard object reference that can be read directly */
+	bool bDirectAccess = false;
+
+	bool IsValid() const
+	{
+		return Property != nullptr;
+	}
+
+	/**
+	 * Read referenced object from container
+	 *
+	 * @param Container Object that owns the property
+	 * @return Object stored in property or null
+	 */
+	FORCEINLINE UObject* Resolve(const void* Container) const
+	{
+		if (!Property || !Container)
+		{
+			return nullptr;
+		}
+
+		const uint8* ValuePtr = static_cast<const uint8*>(Container) + Offset;
+		if (bDirectAccess)
+		{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+			return *reinterpret_cast<UObject* const*>(ValuePtr);
+#else
+			return reinterpret_cast<const TObjectPtr<UObject>*>(ValuePtr)->Get();
+#endif
+		}
+		return Property->GetObjectPropertyValue(ValuePtr);
+	}
+};
+
+/**
+ * Parsed selector of a Dynamic-mode reference: "Tag:Name" or "Class:/Script/Module.ClassName"
+ */
+struct BLUEPRINTCOMPONENTREFERENCE_API FComponentReferenceSelector
+{
+	enum class EKind : uint8
+	{
+		/** Malformed selector or class not found */
+		Invalid,
+		/** First component with tag in ComponentTags */
+		Tag,
+		/** First component of class */
+		Class,
+	};
+
+	EKind Kind = EKind::Invalid;
+	/** Selected tag */
+	FName Tag;
+	/** Selected component class */
+	TWeakObjectPtr<UClass> Class;
+
+	bool IsValid() const
+	{
+		return Kind != EKind::Invalid;
+	}
+};
+
+/**
+ * Component generation of one actor, shared with cached reference helpers.
+ *
+ * Helpers keep a reference to it from resolve and validate cache hits with one load instead of looking actor up.
+ * Written on game thread, can be read from any thread. Zero never matches: it marks state that is outdated or dropped.
+ */
+struct FActorGenerationSlot
+{
+	std::atomic<uint32> Value { 0 };
+
+	uint32 Load() const
+	{
+		return Value.load(std::memory_order_acquire);
+	}
+};
+
+using FActorGenerationRef = TSharedPtr<const FActorGenerationSlot, ESPMode::ThreadSafe>;
+
+/**
+ * Immutable resolve result published by TConcurrentCachedComponentReference to worker threads
+ */
+struct FPublishedComponentRecord
+{
+	/** Resolved component, checked by readers before use */
+	TWeakObjectPtr<UActorComponent> Component;
+	/** Component generation of actor at the time of resolve */
+	uint32 Generation = 0;
+};
+
+/**
+ * Global (Class, Name) -> resolution plan cache used by Property-mode references.
+ *
+ * Lookups are lock-free and can be done from any thread: plans are published as immutable snapshots
+ * and a new snapshot is published when plans of a class are added, so lookups are cheap while writes are rare.
+ *
+ * Cache is dropped on hot reload, class reinstancing and blueprint recompilation,
+ * entries of destroyed classes are pruned after garbage collection.
+ *
+ * Also holds per-actor component name index used by Path-mode references and
+ * tag and class indices used by Dynamic-mode references.
+ */
+class BLUEPRINTCOMPONENTREFERENCE_API FBlueprintComponentReferenceCache
+{
+public:
+	/**
+	 * Find or build resolution plan for property in class.
+	 *
+	 * First lookup in a class builds plans for all its object properties at once.
+	 * Can be called from any thread, but call must not overlap garbage collection:
+	 * replaced snapshots are freed after collection on assumption that no lookup is in progress.
+	 *
+	 * @param InClass Class to search property in
+	 * @param InName Property name
+	 * @return Resolution plan, invalid if property not found
+	 */
+	static FComponentReferencePlan FindPlan(const UClass* InClass, FName InName);
+
+	/**
+	 * Find component owned by actor by its object name.
+	 *
+	 * Uses per-actor name index that is built lazily on first lookup and rebuilt when set of
+	 * owned components changes, lookups outside of game thread go directly to object hash.
+	 *
+	 * @param InActor Actor to search component in
+	 * @param InName Component object name
+	 * @return Found component or null
+	 */
+	static UActorComponent* FindComponentByName(const AActor* InActor, FName InName);
+
+	/**
+	 * Find component through chain of child actor components.
+	 *
+	 * Each segment is resolved as property name using resolution plan of current actor class, then as component name.
+	 * Every segment but last must be a child actor component, search continues in its spawned actor.
+	 *
+	 * @param InActor Actor to start search in
+	 * @param InPath Segments joined with dot, "Child.Sub.Component"
+	 * @return Found component or null
+	 */
+	static UActorComponent* FindNestedComponent(const AActor* InActor, FName InPath);
+
+	/**
+	 * Get segments of nested path, each distinct path is split once.
+	 *
+	 * @param InPath Segments joined with dot
+	 * @return Path segments, valid until module shutdown
+	 */
+	static TConstArrayView<FName> FindPathSegments(FName InPath);
+
+	/**
+	 * Get parsed selector of Dynamic-mode reference, each distinct selector is parsed once
+	 *
+	 * @param InValue Selector text, "Tag:Name" or "Class:/Script/Module.ClassName"
+	 * @return Parsed selector, invalid if malformed or class is not loaded
+	 */
+	static FComponentReferenceSelector FindSelector(FName InValue);
+
+	/**
+	 * Find component selected by Dynamic-mode reference
+	 *
+	 * @param InActor Actor to search component in
+	 * @param InValue Selector text
+	 * @return Found component or null
+	 */
+	static UActorComponent* FindDynamicComponent(const AActor* InActor, FName InValue);
+
+	/**
+	 * Find first component owned by actor that has tag.
+	 *
+	 * Uses per-actor tag index that is built on first lookup and rebuilt when actor generation changes.
+	 * Found components are checked to still have the tag, tags missing from index are searched by scanning components,
+	 * so tags added to existing components are found as well. Order of components with same tag is kept only
+	 * if such changes are reported with InvalidateActor.
+	 *
+	 * @param InActor Actor to search component in
+	 * @param InTag Component tag
+	 * @return Found component or null
+	 */
+	static UActorComponent* FindComponentByTag(const AActor* InActor, FName InTag);
+
+	/**
+	 * Find first component owned by actor that is of class.
+	 *
+	 * Result for each queried class, including a miss, is remembered until actor generation changes.
+	 *
+	 * @param InActor Actor to search component in
+	 * @param InClass Component class
+	 * @return Found component or null
+	 */
+	static UActorComponent* FindComponentByClass(const AActor* InActor, const UClass* InClass);
+
+	/**
+	 * Check reference can be resolved in instances of actor class, judging by class defaults only.
+	 *
+	 * Property references must name a component property of class.
+	 * Path references must name a default subobject component or a construction script component of class.
+	 * Nested references are followed through child actor classes set in defaults, each segment but last must be
+	 * a child actor component and last one is checked as a Property or Path segment in child actor class.
+	 * When a child actor class is not set in defaults it is chosen at runtime and the rest of path is accepted unchecked.
+	 * Dynamic references must have a well-formed selector, selected components may be added at runtime.
+	 * Null reference is never resolvable.
+	 *
+	 * Used both by cook validation and by startup check of declared literals.
+	 *
+	 * @param InReference Reference to check
+	 * @param InActorClass Actor class reference is resolved in
+	 * @return True if reference can point to a component of that class
+	 */
+	static bool CanResolveInClass(const FBlueprintComponentReference& InReference, const UClass* InActorClass);
+
+	/**
+	 * Drop cached per-actor data and start new component generation of actor.
+	 *
+	 * Added and destroyed components are detected automatically, to be called for changes that can not be
+	 * observed: tags of existing components, components moved between actors, property values pointed to another existing component.
+	 */
+	static void InvalidateActor(const AActor* InActor);
+
+	/**
+	 * Drop cached per-actor data of actor that is being destroyed.
+	 */
+	static void ForgetActor(const AActor* InActor);
+
+	/**
+	 * Get component generation of actor, it changes each time a component is added to or removed from actor,
+	 * actor is reported with InvalidateActor or cached plans are dropped.
+	 *
+	 * Generations are unique across actors, used by cached reference templates to detect stale entries.
+	 * Read only: does not create state for actor, use AcquireActorGeneration when resolving.
+	 *
+	 * @param InActor Actor to get generation of
+	 * @return Current generation, 0 for null actor, actor without up to date state or when called outside of game thread
+	 */
+	static uint32 GetActorGeneration(const AActor* InActor);
+
+	/**
+	 * Get generation slot of actor, creating its state or starting a new generation if it is outdated.
+	 *
+	 * Slot stays valid while referenced: creation of a component in actor, InvalidateActor and Reset
+	 * change or zero its value, so a helper that keeps the slot validates hits without any lookup.
+	 * Destroyed components are not reflected in slot until next acquire or RefreshActor, hits must check cached component is still valid.
+	 *
+	 * @param InActor Actor to get generation slot of
+	 * @return Slot with current generation, null for null actor or when called outside of game thread
+	 */
+	static FActorGenerationRef AcquireActorGeneration(const AActor* InActor);
+
+	/**
+	 * Take ownership of record that is no longer published, it is deleted after next garbage collection
+	 * since worker threads may still be reading it.
+	 */
+	static void RetirePublishedRecord(const FPublishedComponentRecord* InRecord);
+
+	/**
+	 * Start new component generation of actor if its cached state is outdated: a component was created in it
+	 * or owned components count changed since last access. Engine has no global component unregister or destroy event,
+	 * so this is how destroyed components are picked up without waiting for next resolve.
+	 *
+	 * @param InActor Actor to check
+	 * @return True if actor has cached state and a new generation was started
+	 */
+	static bool RefreshActor(const AActor* InActor);
+
+	/**
+	 * Take actors of world which cached state was marked dirty by component created in them while tracking is active.
+	 *
+	 * Creation is seen from object allocation, before component is constructed and registered, so it only marks
+	 * state dirty and lists actor, any further work is left to whoever drains the list at a safe point.
+	 * Actors without cached state are not listed.
+	 *
+	 * @param InWorld World to take actors of, actors of other worlds are kept
+	 * @param OutActors Appended with taken actors
+	 */
+	static void TakeDirtyActors(const UWorld* InWorld, TArray<AActor*>& OutActors);
+
+	/**
+	 * Are there any actors listed by created components, see TakeDirtyActors
+	 */
+	static bool HasDirtyActors();
+
+	/**
+	 * Start tracking creation of components, called on module startup
+	 */
+	static void StartTracking();
+
+	/**
+	 * Stop tracking creation of components, called on module shutdown
+	 */
+	static void StopTracking();
+
+	/**
+	 * Drop all cached plans and per-actor data
+	 */
+	static void Reset();
+
+	/**
+	 * Get current cache generation, it changes each time cached plans are dropped.
+	 *
+	 * Used by precompiled handles to detect plans that were built before reinstancing.
+	 */
+	static uint32 GetGeneration();
+
+	/**
+	 * Remove plans and indices that belong to destroyed classes and actors
+	 */
+	static void PruneStaleEntries();
+
+private:
+	static UActorComponent* FindComponentBySegment(const AActor* InActor, FName InSegment);
+};
@@ -1,13 +1,476 @@
 ﻿// Copyright 2024, Aquanox.
 
 #include "BlueprintComponentReferenceLibrary.h"
+#include "ResolvedComponentReferenceHandle.h"
+#include "BlueprintComponentReferenceCache.h"
 #include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "UObject/UObjectGlobals.h"
 
 inline bool TestComponentClass(UActorComponent* In, UClass* InClass)
 {
 	return InClass ? In && In->IsA(InClass) : In != nullptr;
 }
 
+/**
+ * Component class test hoisted out of resolve loops.
+ *
+ * Filtering by base component class is skipped, result for last tested component class is reused
+ * as containers usually reference components of a few classes.
+ */
+struct FComponentClassFilter
+{
+	explicit FComponentClassFilter(const UClass* InClass)
+		: Class(InClass != UActorComponent::StaticClass() ? InClass : nullptr)
+	{
+	}
+
+	bool Test(const UActorComponent* In)
+	{
+		if (!In)
+		{
+			return false;
+		}
+		if (!Class)
+		{
+			return true;
+		}
+
+		const UClass* const InClass = In->GetClass();
+		if (InClass != LastClass)
+		{
+			LastClass = InClass;
+			bLastResult = InClass->IsChildOf(Class);
+		}
+		return bLastResult;
+	}
+
+private:
+	const UClass* Class = nullptr;
+	const UClass* LastClass = nullptr;
+	bool bLastResult = false;
+};
+
+static TAutoConsoleVariable<int32> CVarParallelResolveThreshold(
+	TEXT("BCR.ParallelResolveThreshold"),
+	1024,
+	TEXT("Minimum number of actors to resolve component references in parallel"));
+
+/**
+ * References compiled for each distinct class of a batch.
+ *
+ * Handles are built on calling thread, resolving ranges only reads them and may happen on worker threads.
+ */
+struct FComponentReferenceBatchPlan
+{
+	// compiled handles, one block of NumReferences per distinct class
+	TArray<FResolvedComponentReferenceHandle, TInlineAllocator<16>> Handles;
+	// handle block for each actor, INDEX_NONE for null actors
+	TArray<int32> ActorBlocks;
+	int32 NumReferences = 0;
+	// any reference that is not Property mode
+	bool bHasSerialReferences = false;
+
+	void Build(TConstArrayView<FBlueprintComponentReference> References, TConstArrayView<AActor*> Actors)
+	{
+		NumReferences = References.Num();
+		ActorBlocks.SetNumUninitialized(Actors.Num());
+
+		for (const FBlueprintComponentReference& Reference : References)
+		{
+			bHasSerialReferences |= Reference.GetMode() == EBlueprintComponentReferenceMode::Path
+				|| Reference.GetMode() == EBlueprintComponentReferenceMode::Nested
+				|| Reference.GetMode() == EBlueprintComponentReferenceMode::Dynamic;
+		}
+
+		TMap<const UClass*, int32, TInlineSetAllocator<8>> ClassToBlock;
+		const UClass* LastClass = nullptr;
+		int32 LastBlock = INDEX_NONE;
+
+		for (int32 ActorIndex = 0; ActorIndex < Actors.Num(); ++ActorIndex)
+		{
+			const AActor* const Actor = Actors[ActorIndex];
+			if (!Actor)
+			{
+				ActorBlocks[ActorIndex] = INDEX_NONE;
+				continue;
+			}
+
+			// actors usually come in runs of same class, skip lookup for them
+			const UClass* const ActorClass = Actor->GetClass();
+			if (ActorClass != LastClass)
+			{
+				LastClass = ActorClass;
+
+				if (const int32* ExistingBlock = ClassToBlock.Find(ActorClass))
+				{
+					LastBlock = *ExistingBlock;
+				}
+				else
+				{
+					LastBlock = Handles.Num();
+					ClassToBlock.Add(ActorClass, LastBlock);
+					for (const FBlueprintComponentReference& Reference : References)
+					{
+						Handles.Emplace(Reference, ActorClass);
+					}
+				}
+			}
+
+			ActorBlocks[ActorIndex] = LastBlock;
+		}
+	}
+
+	/**
+	 * Path, Nested and Dynamic modes resolve through game thread indices or global object hash that serializes callers on a lock,
+	 * only batches of Property mode references benefit from running on multiple threads.
+	 */
+	bool IsThreadSafe() const
+	{
+		return !bHasSerialReferences;
+	}
+
+	void ResolveRange(TConstArrayView<AActor*> Actors, TArrayView<UActorComponent*> OutComponents, int32 Begin, int32 End) const
+	{
+		for (int32 ActorIndex = Begin; ActorIndex < End; ++ActorIndex)
+		{
+			UActorComponent** const OutRow = OutComponents.GetData() + ActorIndex * NumReferences;
+
+			const int32 Block = ActorBlocks[ActorIndex];
+			if (Block == INDEX_NONE)
+			{
+				FMemory::Memzero(OutRow, NumReferences * sizeof(UActorComponent*));
+				continue;
+			}
+
+			const AActor* const Actor = Actors[ActorIndex];
+			const FResolvedComponentReferenceHandle* const BlockHandles = Handles.GetData() + Block;
+			for (int32 RefIndex = 0; RefIndex < NumReferences; ++RefIndex)
+			{
+				OutRow[RefIndex] = BlockHandles[RefIndex].GetComponent(Actor);
+			}
+		}
+	}
+};
+
+static TAutoConsoleVariable<bool> CVarUseContainerIndex(
+	TEXT("BCR.UseContainerIndex"),
+	true,
+	TEXT("Use cached component lookup for blueprint container search functions"));
+
+/** Element access of TArray<FBlueprintComponentReference> used by container lookup */
+struct FReferenceArrayAccess
+{
+	const TArray<FBlueprintComponentReference>& Array;
+
+	int32 Num() const { return Array.Num(); }
+	/** Changes when storage is reallocated */
+	UPTRINT GetLayout() const { return reinterpret_cast<UPTRINT>(Array.GetData()); }
+	const FBlueprintComponentReference* GetAt(int32 Slot) const { return Array.IsValidIndex(Slot) ? &Array[Slot] : nullptr; }
+
+	template<typename VisitorFunc>
+	void ForEach(VisitorFunc&& Visitor) const
+	{
+		for (int32 Index = 0; Index < Array.Num(); ++Index)
+		{
+			Visitor(Index, Array[Index]);
+		}
+	}
+};
+
+/** Element access of TSet<FBlueprintComponentReference> used by container lookup */
+struct FReferenceSetAccess
+{
+	const TSet<FBlueprintComponentReference>& Set;
+
+	int32 Num() const { return Set.Num(); }
+	/** Changes when sparse storage grows */
+	UPTRINT GetLayout() const { return static_cast<UPTRINT>(Set.GetMaxIndex()); }
+	const FBlueprintComponentReference* GetAt(int32 Slot) const
+	{
+		const FSetElementId Id = FSetElementId::FromInteger(Slot);
+		return Set.IsValidId(Id) ? &Set[Id] : nullptr;
+	}
+
+	template<typename VisitorFunc>
+	void ForEach(VisitorFunc&& Visitor) const
+	{
+		for (auto It = Set.CreateConstIterator(); It; ++It)
+		{
+			Visitor(It.GetId().AsInteger(), *It);
+		}
+	}
+};
+
+/** Key access of TMap<FBlueprintComponentReference, T> used by container lookup */
+struct FReferenceMapAccess
+{
+	FScriptMapHelper& Map;
+
+	int32 Num() const { return Map.Num(); }
+	/** Changes when sparse storage grows */
+	UPTRINT GetLayout() const { return static_cast<UPTRINT>(Map.GetMaxIndex()); }
+	const FBlueprintComponentReference* GetAt(int32 Slot) const
+	{
+		return Slot >= 0 && Slot < Map.GetMaxIndex() && Map.IsValidIndex(Slot)
+			? reinterpret_cast<const FBlueprintComponentReference*>(Map.GetKeyPtr(Slot))
+			: nullptr;
+	}
+
+	template<typename VisitorFunc>
+	void ForEach(VisitorFunc&& Visitor) const
+	{
+		for (int32 Index = 0, Max = Map.GetMaxIndex(); Index < Max; ++Index)
+		{
+			if (Map.IsValidIndex(Index))
+			{
+				Visitor(Index, *reinterpret_cast<const FBlueprintComponentReference*>(Map.GetKeyPtr(Index)));
+			}
+		}
+	}
+};
+
+static TAutoConsoleVariable<int32> CVarContainerIndexLimit(
+	TEXT("BCR.ContainerIndexLimit"),
+	512,
+	TEXT("Max number of container lookups kept for blueprint container search functions, least recently used are dropped first"));
+
+/**
+ * Component -> slot lookup over a container of references, used by blueprint container search functions.
+ *
+ * Blueprint containers have no change notification, lookup is kept while container size, storage layout
+ * and component generation of actor stay the same, which is checked in constant time.
+ * Every found slot is verified by comparing revision of its element and resolving it, a failed check rebuilds lookup.
+ * Searches that find nothing trust lookup, element revisions are compared with container at most once per frame
+ * to catch elements replaced in place, so repeated misses do not rescan container.
+ *
+ * Lookups are keyed by container address, which for temporaries and by-value pins is never seen again,
+ * so number of lookups is capped (see BCR.ContainerIndexLimit) and lookups of destroyed actors are dropped after garbage collection.
+ *
+ * Values of component properties changed to another existing component are not detected,
+ * such actors should be reported with FBlueprintComponentReferenceCache::InvalidateActor.
+ */
+struct FComponentReferenceContainerIndex
+{
+	// revision of each reference in container iteration order at build time
+	TArray<uint32> Revisions;
+	// container slot of each reference, sparse index for sets and maps
+	TArray<int32> Slots;
+	// resolved component to position of first reference that resolves to it
+	TMap<TObjectKey<UActorComponent>, int32> ByComponent;
+	// container size at build time
+	int32 NumSource = INDEX_NONE;
+	// container storage layout at build time
+	UPTRINT SourceLayout = 0;
+	// generation slot of actor, set while Generation is not zero
+	FActorGenerationRef ActorGeneration;
+	// component generation of actor at build time
+	uint32 Generation = 0;
+	// frame element revisions were last compared with container
+	uint64 VerifiedFrame = 0;
+	// frame lookup was last used, for eviction
+	uint64 UsedFrame = 0;
+
+	/**
+	 * Find container slot of reference that resolves to component
+	 *
+	 * @param Actor Actor to resolve references in
+	 * @param Component Component to search
+	 * @param Access Container element access
+	 * @return slot or INDEX_NONE if not found
+	 */
+	template<typename AccessType>
+	int32 Find(AActor* Actor, const UActorComponent* Component, const AccessType& Access)
+	{
+		UsedFrame = GFrameCounter;
+
+		if (!IsUpToDate(Access))
+		{
+			Build(Actor, Access);
+			return FindIndexed(Actor, Component, Access);
+		}
+
+		bool bStale = false;
+		const int32 Slot = FindIndexed(Actor, Component, Access, &bStale);
+		if (Slot != INDEX_NONE)
+		{
+			return Slot;
+		}
+
+		if (bStale || (VerifiedFrame != GFrameCounter && !HasSameElements(Access)))
+		{
+			Build(Actor, Access);
+			return FindIndexed(Actor, Component, Access);
+		}
+
+		VerifiedFrame = GFrameCounter;
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Get lookup for container used with actor, game thread only.
+	 *
+	 * When limit is reached lookups of destroyed actors are dropped, then least recently used one.
+	 */
+	static FComponentReferenceContainerIndex& Get(const void* Container, const AActor* Actor)
+	{
+		check(IsInGameThread());
+
+		TMap<FIndexKey, FComponentReferenceContainerIndex>& Indices = GetIndices();
+		const FIndexKey Key(Container, TObjectKey<AActor>(Actor));
+		if (FComponentReferenceContainerIndex* Existing = Indices.Find(Key))
+		{
+			return *Existing;
+		}
+
+		if (Indices.Num() >= FMath::Max(1, CVarContainerIndexLimit.GetValueOnGameThread()))
+		{
+			PruneStaleEntries();
+		}
+		if (Indices.Num() >= FMath::Max(1, CVarContainerIndexLimit.GetValueOnGameThread()))
+		{
+			EvictLeastRecentlyUsed();
+		}
+
+		return Indices.Add(Key);
+	}
+
+	static bool IsEnabled()
+	{
+		return IsInGameThread() && CVarUseContainerIndex.GetValueOnGameThread();
+	}
+
+	/** Drop lookups of destroyed actors, registered by module to run after garbage collection */
+	static void PruneStaleEntries()
+	{
+		for (auto It = GetIndices().CreateIterator(); It; ++It)
+		{
+			if (It->Key.Value.ResolveObjectPtr() == nullptr)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	/** Drop all lookups, called on module shutdown */
+	static void Reset()
+	{
+		GetIndices().Empty();
+	}
+
+private:
+	using FIndexKey = TPair<const void*, TObjectKey<AActor>>;
+
+	static TMap<FIndexKey, FComponentReferenceContainerIndex>& GetIndices()
+	{
+		static TMap<FIndexKey, FComponentReferenceContainerIndex> Indices;
+		return Indices;
+	}
+
+	static void EvictLeastRecentlyUsed()
+	{
+		TMap<FIndexKey, FComponentReferenceContainerIndex>& Indices = GetIndices();
+
+		const FIndexKey* Oldest = nullptr;
+		uint64 OldestFrame = MAX_uint64;
+		for (const auto& Pair : Indices)
+		{
+			if (Pair.Value.UsedFrame < OldestFrame)
+			{
+				Oldest = &Pair.Key;
+				OldestFrame = Pair.Value.UsedFrame;
+			}
+		}
+
+		if (Oldest)
+		{
+			const FIndexKey Key = *Oldest;
+			Indices.Remove(Key);
+		}
+	}
+
+	template<typename AccessType>
+	bool IsUpToDate(const AccessType& Access) const
+	{
+		return NumSource == Access.Num()
+			&& SourceLayout == Access.GetLayout()
+			&& Generation != 0
+			&& Generation == ActorGeneration->Load();
+	}
+
+	template<typename AccessType>
+	bool HasSameElements(const AccessType& Access) const
+	{
+		for (int32 Pos = 0; Pos < Revisions.Num(); ++Pos)
+		{
+			const FBlueprintComponentReference* Element = Access.GetAt(Slots[Pos]);
+			if (!Element || Element->GetRevision() != Revisions[Pos])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename AccessType>
+	int32 FindIndexed(AActor* Actor, const UActorComponent* Component, const AccessType& Access, bool* OutStale = nullptr) const
+	{
+		if (const int32* Found = ByComponent.Find(Component))
+		{
+			const int32 Pos = *Found;
+			const FBlueprintComponentReference* Element = Access.GetAt(Slots[Pos]);
+			if (Element && Element->GetRevision() == Revisions[Pos] && Element->GetComponent(Actor) == Component)
+			{
+				return Slots[Pos];
+			}
+			if (OutStale)
+			{ // element replaced in place or property value changed
+				*OutStale = true;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	template<typename AccessType>
+	void Build(AActor* Actor, const AccessType& Access)
+	{
+		NumSource = Access.Num();
+		SourceLayout = Access.GetLayout();
+		ActorGeneration = FBlueprintComponentReferenceCache::AcquireActorGeneration(Actor);
+		Generation = ActorGeneration.IsValid() ? ActorGeneration->Load() : 0;
+		VerifiedFrame = GFrameCounter;
+		Revisions.Reset(NumSource);
+		Slots.Reset(NumSource);
+		ByComponent.Reset();
+
+		Access.ForEach([this, Actor](int32 Slot, const FBlueprintComponentReference& Reference)
+		{
+			const int32 Pos = Revisions.Add(Reference.GetRevision());
+			Slots.Add(Slot);
+
+			if (UActorComponent* Component = Reference.GetComponent(Actor))
+			{
+				if (!ByComponent.Contains(Component))
+				{
+					ByComponent.Add(Component, Pos);
+				}
+			}
+		});
+	}
+};
+
+void UBlueprintComponentReferenceLibrary::PruneContainerIndices()
+{
+	FComponentReferenceContainerIndex::PruneStaleEntries();
+}
+
+void UBlueprintComponentReferenceLibrary::ResetContainerIndices()
+{
+	FComponentReferenceContainerIndex::Reset();
+}
+
 template<typename TBase = FBlueprintComponentReference>
 bool ResolveComponentInternal(const TBase& Reference, AActor* Actor, UClass* Class, UActorComponent*& Component)
 {
@@ -32,12 +495,17 @@ void UBlueprintComponentReferenceLibrary::TryGetReferencedComponent(const FBluep
 
 void UBlueprintComponentReferenceLibrary::GetReferencedComponents(const TArray<FBlueprintComponentReference>& References, AActor* Actor, TSubclassOf<UActorComponent> Class, bool bKeepNulls, TArray<UActorComponent*>& Components)
 {
-	Components.Empty();
+	// keep storage of output, blueprint graphs pass same variable on each call
+	Components.Reset(References.Num());
 
+	FComponentClassFilter Filter(Class.Get());
 	for (const FBlueprintComponentReference& Reference : References)
 	{
-		UActorComponent* Component = nullptr;
-		ResolveComponentInternal(Reference, Actor, Class, Component);
+		UActorComponent* Component = Reference.GetComponent(Actor);
+		if (!Filter.Test(Component))
+		{
+			Component = nullptr;
+		}
 
 		if (Component != nullptr || bKeepNulls)
 		{
@@ -48,20 +516,82 @@ void UBlueprintComponentReferenceLibrary::GetReferencedComponents(const TArray<F
 
 void UBlueprintComponentReferenceLibrary::GetSetReferencedComponents(const TSet<FBlueprintComponentReference>& References, AActor* Actor, TSubclassOf<UActorComponent> Class, TSet<UActorComponent*>& Components)
 {
-	Components.Empty();
+	// keep storage of output, blueprint graphs pass same variable on each call
+	Components.Reset();
+	Components.Reserve(References.Num());
 
+	FComponentClassFilter Filter(Class.Get());
 	for (const FBlueprintComponentReference& Reference : References)
 	{
-		UActorComponent* Component = nullptr;
-		ResolveComponentInternal(Reference, Actor, Class, Component);
-
-		if (Component != nullptr)
+		UActorComponent* Component = Reference.GetComponent(Actor);
+		if (Filter.Test(Component))
 		{
 			Components.Add(Component);
 		}
 	}
 }
 
+void UBlueprintComponentReferenceLibrary::GetReferencedComponentForActors(const FBlueprintComponentReference& Reference, const TArray<AActor*>& Actors, TSubclassOf<UActorComponent> Class, TArray<UActorComponent*>& Components)
+{
+	Components.SetNumUninitialized(Actors.Num());
+
+	ResolveComponentsBatch(MakeArrayView(&Reference, 1), Actors, Components);
+
+	if (UClass* const FilterClass = Class.Get())
+	{
+		FComponentClassFilter Filter(FilterClass);
+		for (UActorComponent*& Component : Components)
+		{
+			if (!Filter.Test(Component))
+			{
+				Component = nullptr;
+			}
+		}
+	}
+}
+
+void UBlueprintComponentReferenceLibrary::ResolveComponentsBatch(TConstArrayView<FBlueprintComponentReference> References, TConstArrayView<AActor*> Actors, TArrayView<UActorComponent*> OutComponents)
+{
+	check(OutComponents.Num() >= Actors.Num() * References.Num());
+
+	FComponentReferenceBatchPlan Plan;
+	Plan.Build(References, Actors);
+	Plan.ResolveRange(Actors, OutComponents, 0, Actors.Num());
+}
+
+void UBlueprintComponentReferenceLibrary::ResolveComponentsParallel(TConstArrayView<FBlueprintComponentReference> References, TConstArrayView<AActor*> Actors, TArrayView<UActorComponent*> OutComponents, int32 NumChunks)
+{
+	check(OutComponents.Num() >= Actors.Num() * References.Num());
+
+	FComponentReferenceBatchPlan Plan;
+	Plan.Build(References, Actors);
+
+	if (NumChunks <= 0)
+	{
+		NumChunks = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	}
+	NumChunks = FMath::Min(NumChunks, Actors.Num());
+
+	const bool bCanRunParallel = Plan.IsThreadSafe()
+		&& IsInGameThread()
+		&& NumChunks > 1
+		&& Actors.Num() >= CVarParallelResolveThreshold.GetValueOnGameThread();
+
+	if (!bCanRunParallel)
+	{
+		Plan.ResolveRange(Actors, OutComponents, 0, Actors.Num());
+		return;
+	}
+
+	const int32 ChunkSize = FMath::DivideAndRoundUp(Actors.Num(), NumChunks);
+	ParallelFor(NumChunks, [&Plan, Actors, OutComponents, ChunkSize](int32 ChunkIndex)
+	{
+		const int32 Begin = ChunkIndex * ChunkSize;
+		const int32 End = FMath::Min(Begin + ChunkSize, Actors.Num());
+		Plan.ResolveRange(Actors, OutComponents, Begin, End);
+	});
+}
+
 bool UBlueprintComponentReferenceLibrary::IsNullComponentReference(const FBlueprintComponentReference& Reference)
 {
 	return Reference.IsNull();
@@ -92,36 +622,36 @@ FString UBlueprintComponentReferenceLibrary::Conv_ComponentReferenceToString(con
 	return Reference.ToString();
 }
 
-bool UBlueprintComponentReferenceLibrary::Array_ContainsComponent(const TArray<FBlueprintComponentReference>& TargetArray, UActorComponent* ItemToFind)
+template<typename AccessType>
+bool ContainsComponentInternal(const void* Container, const AccessType& Access, UActorComponent* ItemToFind)
 {
-	if(TargetArray.Num() && ItemToFind && ItemToFind->GetOwner())
+	if(Access.Num() && ItemToFind && ItemToFind->GetOwner())
 	{
 		AActor* SearchTarget = ItemToFind->GetOwner();
-		for (const FBlueprintComponentReference& Reference : TargetArray)
+		if (FComponentReferenceContainerIndex::IsEnabled())
 		{
-			if (Reference.GetComponent(SearchTarget) != nullptr)
-			{
-				return true;
-			}
+			FComponentReferenceContainerIndex& Index = FComponentReferenceContainerIndex::Get(Container, SearchTarget);
+			return Index.Find(SearchTarget, ItemToFind, Access) != INDEX_NONE;
 		}
+
+		bool bFound = false;
+		Access.ForEach([SearchTarget, ItemToFind, &bFound](int32, const FBlueprintComponentReference& Reference)
+		{
+			bFound = bFound || Reference.GetComponent(SearchTarget) == ItemToFind;
+		});
+		return bFound;
 	}
 	return false;
 }
 
+bool UBlueprintComponentReferenceLibrary::Array_ContainsComponent(const TArray<FBlueprintComponentReference>& TargetArray, UActorComponent* ItemToFind)
+{
+	return ContainsComponentInternal(&TargetArray, FReferenceArrayAccess { TargetArray }, ItemToFind);
+}
+
 bool UBlueprintComponentReferenceLibrary::Set_ContainsComponent(const TSet<FBlueprintComponentReference>& TargetSet, UActorComponent* ItemToFind)
 {
-	if(TargetSet.Num() && ItemToFind && ItemToFind->GetOwner())
-	{
-		AActor* SearchTarget = ItemToFind->GetOwner();
-		for (const FBlueprintComponentReference& Reference : TargetSet)
-		{
-			if (Reference.GetComponent(SearchTarget) != nullptr)
-			{
-				return true;
-			}
-		}
-	}
-	return false;
+	return ContainsComponentInternal(&TargetSet, FReferenceSetAccess { TargetSet }, ItemToFind);
 }
 
 bool UBlueprintComponentReferenceLibrary::Map_FindComponent(const TMap<int32, int32>& TargetMap, UActorComponent* Component, int32& Value)
@@ -148,35 +678,29 @@ bool UBlueprintComponentReferenceLibrary::Map_FindComponent_Impl(const void* Tar
 		uint8* FoundValuePtr = nullptr;
 		
 		FScriptMapHelper MapHelper(MapProperty, TargetMap);
+		const FReferenceMapAccess Access { MapHelper };
 
-#if UE_VERSION_OLDER_THAN(5, 0, 0)
-		int32 Size = MapHelper.Num();
-		for( int32 I = 0; Size; ++I )
+		if (FComponentReferenceContainerIndex::IsEnabled())
 		{
-			if(MapHelper.IsValidIndex(I))
+			FComponentReferenceContainerIndex& Index = FComponentReferenceContainerIndex::Get(TargetMap, SearchTarget);
+
+			const int32 Slot = Index.Find(SearchTarget, SearchComponent, Access);
+			if (Slot != INDEX_NONE)
 			{
-				const FBlueprintComponentReference* Reference = reinterpret_cast<const FBlueprintComponentReference*>(MapHelper.GetKeyPtr(I));
-				if (Reference->GetComponent(SearchTarget) == SearchComponent)
-				{
-					FoundValuePtr = MapHelper.GetValuePtr(I);
-					break;
-				}
-				--Size;
+				FoundValuePtr = MapHelper.GetValuePtr(Slot);
 			}
 		}
-#else
-		for (FScriptMapHelper::FIterator It(MapHelper); It; ++It)
+		else
 		{
-			const FBlueprintComponentReference* pKey = reinterpret_cast<const FBlueprintComponentReference*>(MapHelper.GetKeyPtr(It));
-			uint8* pValue = MapHelper.GetValuePtr(It);
-
-			if (pKey->GetComponent(SearchTarget) == SearchComponent)
+			for (int32 Slot = 0, Max = MapHelper.GetMaxIndex(); Slot < Max && !FoundValuePtr; ++Slot)
 			{
-				FoundValuePtr = pValue;
-				break;
+				const FBlueprintComponentReference* Reference = Access.GetAt(Slot);
+				if (Reference && Reference->GetComponent(SearchTarget) == SearchComponent)
+				{
+					FoundValuePtr = MapHelper.GetValuePtr(Slot);
+				}
 			}
 		}
-#endif
 		
 		if (OutValuePtr)
 		{
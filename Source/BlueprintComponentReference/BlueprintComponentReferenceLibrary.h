@@ -39,18 +39,22 @@ public:
 	/**
 	 * Resolve component reference in specified actor (pure).
 	 *
+	 * Placed in graphs with UK2Node_GetReferencedComponent that compiles literal property references to direct variable access.
+	 *
 	 * @param Reference Component reference to resolve
 	 * @param Actor Target actor
 	 * @param Class Expected component class
 	 * @param Component Resolved component
 	 * @return True if component found, False otherwise
 	 */
-	UFUNCTION(BlueprintPure, Category="Utilities|ComponentReference", meta=( DefaultToSelf="Actor", DeterminesOutputType="Class", DynamicOutputParam="Component", Keywords="cref"))
+	UFUNCTION(BlueprintPure, Category="Utilities|ComponentReference", meta=( DefaultToSelf="Actor", DeterminesOutputType="Class", DynamicOutputParam="Component", Keywords="cref", BlueprintInternalUseOnly=true))
 	static UPARAM(DisplayName="Success") bool GetReferencedComponent(const FBlueprintComponentReference& Reference, AActor* Actor, TSubclassOf<UActorComponent> Class, UActorComponent*& Component);
 
 	/**
 	 * Resolve array of component references in specific actor
 	 *
+	 * Output array storage is reused between calls.
+	 *
 	 * @param References Component reference to resolve
 	 * @param Actor Target actor
 	 * @param Class Expected component class
@@ -63,6 +67,8 @@ public:
 	/**
 	 * Resolve set of component references in specific actor
 	 *
+	 * Output set storage is reused between calls.
+	 *
 	 * @param References Component reference to resolve
 	 * @param Actor Target actor
 	 * @param Class Expected component class
@@ -71,6 +77,49 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Utilities|ComponentReference|Containers", meta=(DisplayName="Get Referenced Components (Set)", DefaultToSelf="Actor", DeterminesOutputType="Class", DynamicOutputParam="Components", Keywords="cref"))
 	static void GetSetReferencedComponents(const TSet<FBlueprintComponentReference>& References, AActor* Actor, TSubclassOf<UActorComponent> Class, TSet<UActorComponent*>& Components);
 
+	/**
+	 * Resolve component reference in each of specified actors.
+	 *
+	 * Reference is compiled once per distinct actor class, output preserves order of actors.
+	 *
+	 * @param Reference Component reference to resolve
+	 * @param Actors Target actors
+	 * @param Class Expected component class
+	 * @param Components Resolved components, null entries for actors where resolve failed
+	 */
+	UFUNCTION(BlueprintCallable, Category="Utilities|ComponentReference|Containers", meta=(DisplayName="Get Referenced Component (Actors)", DeterminesOutputType="Class", DynamicOutputParam="Components", Keywords="cref batch"))
+	static void GetReferencedComponentForActors(const FBlueprintComponentReference& Reference, const TArray<AActor*>& Actors, TSubclassOf<UActorComponent> Class, TArray<UActorComponent*>& Components);
+
+	/**
+	 * Resolve component references against multiple actors.
+	 *
+	 * Actors are grouped by class and each reference is compiled once per class.
+	 * Results are written row by row: OutComponents[ActorIndex * References.Num() + ReferenceIndex].
+	 *
+	 * @param References Component references to resolve
+	 * @param Actors Target actors
+	 * @param OutComponents Output buffer, must hold Actors.Num() * References.Num() elements
+	 */
+	static void ResolveComponentsBatch(TConstArrayView<FBlueprintComponentReference> References, TConstArrayView<AActor*> Actors, TArrayView<UActorComponent*> OutComponents);
+
+	/**
+	 * Parallel version of ResolveComponentsBatch, splits actors into chunks processed by task graph workers.
+	 *
+	 * Only batches made entirely of Property mode references are resolved in parallel:
+	 * - Property mode references are compiled on calling thread and resolved on workers by reading property values at fixed offsets.
+	 * - Path, Nested and Dynamic mode references go through game thread component indices or global object hash
+	 *   that serializes lookups on a lock, batches that contain any of them are resolved on calling thread.
+	 *
+	 * Must be called from game thread, actors and their components must not change while call is in progress.
+	 * Batches smaller than BCR.ParallelResolveThreshold actors are resolved on calling thread.
+	 *
+	 * @param References Component references to resolve
+	 * @param Actors Target actors
+	 * @param OutComponents Output buffer, must hold Actors.Num() * References.Num() elements
+	 * @param NumChunks Number of chunks to split actors into, 0 to use one chunk per worker thread
+	 */
+	static void ResolveComponentsParallel(TConstArrayView<FBlueprintComponentReference> References, TConstArrayView<AActor*> Actors, TArrayView<UActorComponent*> OutComponents, int32 NumChunks = 0);
+
 	/**
 	 * Does the component reference have no value set?
 	 *
@@ -110,9 +159,11 @@ public:
 	static FString Conv_ComponentReferenceToString(const FBlueprintComponentReference& Reference);
 
 	/**
-	 * Returns true if the array contains the given item
+	 * Returns true if any reference in the array resolves to the given item
 	 *
-	 * Uses Component's Owner as Search Target to resolve components. 
+	 * Uses Component's Owner as Search Target to resolve components.
+	 * Resolved components are cached per array and owner (see BCR.UseContainerIndex), repeated checks are a single lookup
+	 * while array size, storage and owner components stay the same.
 	 *
 	 * @param	TargetArray		The array to search for the item
 	 * @param	ItemToFind		The item to look for
@@ -122,9 +173,11 @@ public:
 	static bool Array_ContainsComponent(const TArray<FBlueprintComponentReference>& TargetArray, UActorComponent* ItemToFind);
 	
 	/**
-	 * Returns true if set contains the given item
+	 * Returns true if any reference in the set resolves to the given item
 	 *
-	 * Uses Component's Owner as Search Target to resolve components. 
+	 * Uses Component's Owner as Search Target to resolve components.
+	 * Resolved components are cached per set and owner (see BCR.UseContainerIndex), repeated checks are a single lookup
+	 * while set size, storage and owner components stay the same.
 	 *
 	 * @param	TargetSet		The set to search for the item
 	 * @param	ItemToFind		The item to look for
@@ -136,9 +189,8 @@ public:
 	/** 
 	 * EXPERIMENTAL: Fast search of component within TMap<FBlueprintComponentReference, GenericValue> for blueprint users
 	 *
-	 * WARNING: It is just a decorated loop due to need to invoke GetComponent on each component reference
-	 * to obtain referenced component for comparsion, but should be much faster than doing it in pure blueprint
-	 * and there is no need to use blueprint macro library ForEach/ForEachWithBreak
+	 * First search in a map resolves all keys and builds a component to value lookup for map and actor,
+	 * following searches reuse it while map size, storage and actor components stay the same (see BCR.UseContainerIndex).
 	 * 
 	 * Uses Component's Owner as Search Target to resolve components. 
 	 *
@@ -216,7 +268,19 @@ public:
 		PRAGMA_ENABLE_DEPRECATION_WARNINGS
 	}
 
+	/**
+	 * Drop container lookups of destroyed actors, called by module after garbage collection
+	 */
+	static void PruneContainerIndices();
+
+	/**
+	 * Drop all container lookups, called on module shutdown
+	 */
+	static void ResetContainerIndices();
+
 private:
+	friend struct FBlueprintComponentReferenceLibraryTestAccess;
+
 	// Implementation of Map_FindComponent
 	static bool Map_FindComponent_Impl(const void* TargetMap, const FMapProperty* MapProperty, const void* KeyPtr, void* OutValuePtr);
 };
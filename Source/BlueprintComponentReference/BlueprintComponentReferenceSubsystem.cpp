@@ -0,0 +1,359 @@
+// Copyright 2024, Aquanox.
+
+#include "BlueprintComponentReferenceSubsystem.h"
+#include "BlueprintComponentReferenceCache.h"
+#include "ComponentReferenceSchema.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "GameFramework/PlayerController.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("BlueprintComponentReference"), STATGROUP_BlueprintComponentReference, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Process Resolve Queue"), STAT_BCR_ProcessQueue, STATGROUP_BlueprintComponentReference);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Resolve Queue Depth"), STAT_BCR_QueueDepth, STATGROUP_BlueprintComponentReference);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Resolves Processed"), STAT_BCR_NumProcessed, STATGROUP_BlueprintComponentReference);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Resolve Budget Used (ms)"), STAT_BCR_BudgetUsed, STATGROUP_BlueprintComponentReference);
+
+namespace BCRWarmup
+{
+	static TAutoConsoleVariable<bool> CVarWarmupOnSpawn(
+		TEXT("BCR.WarmupOnSpawn"),
+		true,
+		TEXT("Resolve component references of actors when they are spawned or when world begins play"));
+
+	static TAutoConsoleVariable<float> CVarWarmupBudgetMs(
+		TEXT("BCR.WarmupBudgetMs"),
+		0.5f,
+		TEXT("Time in milliseconds spent on queued component reference resolves per frame, remaining entries are processed on following frames"));
+
+	static TAutoConsoleVariable<int32> CVarRecheckActorsPerTick(
+		TEXT("BCR.RecheckActorsPerTick"),
+		32,
+		TEXT("Number of tracked actors checked per tick for destroyed or unregistered components, 0 disables the check"));
+
+	inline bool HasReferences(const AActor* InActor)
+	{
+		return !FComponentReferenceSchema::Get(InActor->GetClass())->IsEmpty();
+	}
+}
+
+bool UBlueprintComponentReferenceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UBlueprintComponentReferenceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::HandleActorSpawned));
+}
+
+void UBlueprintComponentReferenceSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+
+	Pending.Reset();
+	PendingWarmups.Reset();
+	Registered.Reset();
+	Tracked.Reset();
+	RecheckCursor = 0;
+	DirtyScratch.Reset();
+
+	Super::Deinitialize();
+}
+
+void UBlueprintComponentReferenceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (!BCRWarmup::CVarWarmupOnSpawn.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	// placed actors are not reported by spawn handler
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		RequestWarmup(*It);
+	}
+}
+
+void UBlueprintComponentReferenceSubsystem::Tick(float DeltaTime)
+{
+	WarmupChangedActors();
+	ProcessQueue(BCRWarmup::CVarWarmupBudgetMs.GetValueOnGameThread() / 1000.0, true);
+}
+
+bool UBlueprintComponentReferenceSubsystem::IsTickable() const
+{
+	return Pending.Num() > 0 || Tracked.Num() > 0 || FBlueprintComponentReferenceCache::HasDirtyActors();
+}
+
+ETickableTickType UBlueprintComponentReferenceSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UWorld* UBlueprintComponentReferenceSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UBlueprintComponentReferenceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBlueprintComponentReferenceSubsystem, STATGROUP_Tickables);
+}
+
+void UBlueprintComponentReferenceSubsystem::RequestWarmup(AActor* InActor, EComponentReferenceResolvePriority InPriority)
+{
+	if (!IsValid(InActor) || (!BCRWarmup::HasReferences(InActor) && !Registered.Contains(InActor)))
+	{
+		return;
+	}
+
+	bool bAlreadyPending = false;
+	PendingWarmups.Add(InActor, &bAlreadyPending);
+	if (!bAlreadyPending)
+	{
+		Enqueue(InActor, nullptr, InPriority);
+	}
+}
+
+void UBlueprintComponentReferenceSubsystem::Register(AActor* InActor, TFunction<void(AActor*)>&& InResolve)
+{
+	if (!IsValid(InActor))
+	{
+		return;
+	}
+
+	TrackActor(InActor);
+	Registered.FindOrAdd(InActor).Add(MoveTemp(InResolve));
+	RequestWarmup(InActor);
+}
+
+void UBlueprintComponentReferenceSubsystem::WarmupActor(AActor* InActor)
+{
+	FComponentReferenceSchema::WarmupActor(InActor);
+
+	if (const TArray<TFunction<void(AActor*)>>* Resolvers = Registered.Find(InActor))
+	{
+		for (const TFunction<void(AActor*)>& Resolve : *Resolvers)
+		{
+			Resolve(InActor);
+		}
+	}
+}
+
+void UBlueprintComponentReferenceSubsystem::Enqueue(AActor* InActor, TFunction<void(AActor*)>&& InResolve, EComponentReferenceResolvePriority InPriority)
+{
+	if (!IsValid(InActor))
+	{
+		return;
+	}
+
+	TrackActor(InActor);
+
+	FPendingResolve& Entry = Pending.AddDefaulted_GetRef();
+	Entry.Actor = InActor;
+	Entry.Resolve = MoveTemp(InResolve);
+	Entry.Priority = InPriority;
+	bPendingDirty = true;
+
+	SET_DWORD_STAT(STAT_BCR_QueueDepth, Pending.Num());
+}
+
+void UBlueprintComponentReferenceSubsystem::TrackActor(AActor* InActor)
+{
+	bool bAlreadyTracked = false;
+	Tracked.Add(InActor, &bAlreadyTracked);
+	if (!bAlreadyTracked)
+	{
+		InActor->OnEndPlay.AddDynamic(this, &ThisClass::HandleActorEndPlay);
+	}
+}
+
+void UBlueprintComponentReferenceSubsystem::NotifyActorReused(AActor* InActor)
+{
+	if (InActor)
+	{
+		FBlueprintComponentReferenceCache::InvalidateActor(InActor);
+		RequestWarmup(InActor);
+	}
+}
+
+void UBlueprintComponentReferenceSubsystem::NotifyComponentsChanged(AActor* InActor)
+{
+	if (InActor)
+	{
+		FBlueprintComponentReferenceCache::InvalidateActor(InActor);
+		RequestWarmup(InActor);
+	}
+}
+
+void UBlueprintComponentReferenceSubsystem::SortPending()
+{
+	bPendingDirty = false;
+
+	FVector ViewLocation = FVector::ZeroVector;
+	bool bHasViewLocation = false;
+	if (const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+	{
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		bHasViewLocation = true;
+	}
+
+	for (FPendingResolve& Entry : Pending)
+	{
+		const AActor* Actor = Entry.Actor.Get();
+		if (Entry.Priority == EComponentReferenceResolvePriority::High)
+		{
+			Entry.SortKey = MAX_flt;
+		}
+		else if (Actor && bHasViewLocation)
+		{
+			Entry.SortKey = -FVector::DistSquared(ViewLocation, Actor->GetActorLocation());
+		}
+		else
+		{
+			Entry.SortKey = -MAX_flt;
+		}
+	}
+
+	// processed from the end, so highest key goes last
+	Pending.StableSort([](const FPendingResolve& A, const FPendingResolve& B)
+	{
+		return A.SortKey < B.SortKey;
+	});
+}
+
+int32 UBlueprintComponentReferenceSubsystem::ProcessPending()
+{
+	return ProcessQueue(BCRWarmup::CVarWarmupBudgetMs.GetValueOnGameThread() / 1000.0, false);
+}
+
+int32 UBlueprintComponentReferenceSubsystem::Flush()
+{
+	return ProcessQueue(TNumericLimits<double>::Max(), false);
+}
+
+int32 UBlueprintComponentReferenceSubsystem::ProcessQueue(double InBudget, bool bGuaranteeProgress)
+{
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		BudgetUsed = 0;
+	}
+
+	if (Pending.Num() == 0)
+	{
+		return 0;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_BCR_ProcessQueue);
+
+	if (bPendingDirty)
+	{
+		SortPending();
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double EndTime = StartTime + FMath::Max(0.0, InBudget - BudgetUsed);
+
+	int32 NumProcessed = 0;
+	// tick processes at least one entry even with budget spent so queue always drains
+	while (Pending.Num() > 0 && ((bGuaranteeProgress && NumProcessed == 0) || FPlatformTime::Seconds() < EndTime))
+	{
+		FPendingResolve Entry = Pending.Pop();
+		if (AActor* Actor = Entry.Actor.Get())
+		{
+			if (Entry.Resolve)
+			{
+				Entry.Resolve(Actor);
+			}
+			else
+			{
+				PendingWarmups.Remove(Actor);
+				WarmupActor(Actor);
+			}
+			++NumProcessed;
+		}
+	}
+
+	BudgetUsed += FPlatformTime::Seconds() - StartTime;
+
+	SET_DWORD_STAT(STAT_BCR_QueueDepth, Pending.Num());
+	INC_DWORD_STAT_BY(STAT_BCR_NumProcessed, NumProcessed);
+	SET_FLOAT_STAT(STAT_BCR_BudgetUsed, BudgetUsed * 1000.0);
+
+	return NumProcessed;
+}
+
+void UBlueprintComponentReferenceSubsystem::HandleActorSpawned(AActor* InActor)
+{
+	// queue is sorted and drained on tick, spawning many actors in a frame does not resort it per actor
+	if (BCRWarmup::CVarWarmupOnSpawn.GetValueOnGameThread())
+	{
+		RequestWarmup(InActor);
+	}
+}
+
+void UBlueprintComponentReferenceSubsystem::WarmupChangedActors()
+{
+	// components created since last tick, listed by cache while they were allocated
+	DirtyScratch.Reset();
+	FBlueprintComponentReferenceCache::TakeDirtyActors(GetWorld(), DirtyScratch);
+	for (AActor* Actor : DirtyScratch)
+	{
+		// components created while actor is spawned are covered by spawn warmup
+		if (Actor->IsActorInitialized())
+		{
+			RequestWarmup(Actor);
+		}
+	}
+
+	// destroyed and unregistered components have no global event, tracked actors are rechecked by count in slices
+	const int32 MaxIndex = Tracked.GetMaxIndex();
+	const int32 NumToCheck = FMath::Min(BCRWarmup::CVarRecheckActorsPerTick.GetValueOnGameThread(), Tracked.Num());
+	for (int32 NumChecked = 0; NumChecked < NumToCheck && MaxIndex > 0; ++RecheckCursor)
+	{
+		if (RecheckCursor >= MaxIndex)
+		{
+			RecheckCursor = 0;
+		}
+
+		const FSetElementId Id = FSetElementId::FromInteger(RecheckCursor);
+		if (!Tracked.IsValidId(Id))
+		{
+			continue;
+		}
+
+		++NumChecked;
+		AActor* Actor = Tracked[Id].ResolveObjectPtr();
+		if (Actor && FBlueprintComponentReferenceCache::RefreshActor(Actor))
+		{
+			RequestWarmup(Actor);
+		}
+	}
+}
+
+void UBlueprintComponentReferenceSubsystem::HandleActorEndPlay(AActor* InActor, EEndPlayReason::Type InReason)
+{
+	Tracked.Remove(InActor);
+	Registered.Remove(InActor);
+	PendingWarmups.Remove(InActor);
+	InActor->OnEndPlay.RemoveDynamic(this, &ThisClass::HandleActorEndPlay);
+
+	if (InReason == EEndPlayReason::Destroyed || InReason == EEndPlayReason::RemovedFromWorld)
+	{
+		FBlueprintComponentReferenceCache::ForgetActor(InActor);
+	}
+}
@@ -0,0 +1,197 @@
+// Copyright 2024, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Engine/EngineTypes.h"
+#include "UObject/ObjectKey.h"
+#include "BlueprintComponentReferenceSubsystem.generated.h"
+
+class AActor;
+
+/**
+ * Order in which queued resolves are processed
+ */
+enum class EComponentReferenceResolvePriority : uint8
+{
+	/** Processed in order of distance to local player view point */
+	Normal,
+	/** Processed before any normal entry */
+	High
+};
+
+/**
+ * Warms and invalidates component reference caches of actors in game worlds.
+ *
+ * Actors that declare component references (see FComponentReferenceSchema) are queued when
+ * spawned or when world begins play and resolved on following ticks, so the first access during gameplay
+ * does not build property plans and component name index. Cached reference helpers can be queued once
+ * with QueueResolve or registered with RegisterCached to be filled with every warmup of their actor.
+ *
+ * Queue is processed only on tick under per-frame time budget, entries above the budget are processed on following frames.
+ * Explicitly requested entries go first, others are ordered by distance to local player.
+ * Accessing a cached reference before its entry was processed resolves it synchronously,
+ * queued entry then finds it already cached.
+ *
+ * Actors that get a new component after initialization are queued for warmup again on next tick.
+ * Engine has no global event for unregistered or destroyed components, so tracked actors are rechecked
+ * a slice per tick and warmed again when their owned components changed.
+ * Cached per-actor data is dropped when actor ends play. Pooled actors and actors that rename components
+ * or change their tags should be reported with NotifyActorReused or NotifyComponentsChanged.
+ *
+ * Controlled by BCR.WarmupOnSpawn, BCR.WarmupBudgetMs and BCR.RecheckActorsPerTick console variables,
+ * queue depth and budget usage are reported in STATGROUP_BlueprintComponentReference.
+ *
+ * @code
+ *	void AMyActor::BeginPlay()
+ *	{
+ *		Super::BeginPlay();
+ *		GetWorld()->GetSubsystem<UBlueprintComponentReferenceSubsystem>()->QueueResolve(this, CachedTargets);
+ *	}
+ * @endcode
+ */
+UCLASS()
+class BLUEPRINTCOMPONENTREFERENCE_API UBlueprintComponentReferenceSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Queue actor for warmup. Actors without component references or registered helpers are ignored,
+	 * actor already waiting for warmup is not queued twice.
+	 *
+	 * @param InActor Actor to warm
+	 * @param InPriority Queue priority
+	 */
+	void RequestWarmup(AActor* InActor, EComponentReferenceResolvePriority InPriority = EComponentReferenceResolvePriority::Normal);
+
+	/**
+	 * Queue resolve of cached reference helper (TCachedComponentReference and others).
+	 *
+	 * Helper must be owned by the actor, entry is skipped if actor is destroyed before it is processed.
+	 *
+	 * @param InActor Owning actor to resolve in
+	 * @param InCached Cached reference helper
+	 * @param InPriority Queue priority
+	 */
+	template<typename CachedType>
+	void QueueResolve(AActor* InActor, CachedType& InCached, EComponentReferenceResolvePriority InPriority = EComponentReferenceResolvePriority::Normal)
+	{
+		CachedType* Cached = &InCached;
+		Enqueue(InActor, [Cached](AActor* InOwner) { Cached->GetAll(InOwner); }, InPriority);
+	}
+
+	/**
+	 * Register cached reference helper to be resolved with every warmup of its actor: after spawn,
+	 * reuse and component changes. Registration is dropped when actor ends play.
+	 *
+	 * @param InActor Owning actor to resolve in
+	 * @param InCached Cached reference helper, must be owned by the actor
+	 */
+	template<typename CachedType>
+	void RegisterCached(AActor* InActor, CachedType& InCached)
+	{
+		CachedType* Cached = &InCached;
+		Register(InActor, [Cached](AActor* InOwner) { Cached->GetAll(InOwner); });
+	}
+
+	/**
+	 * Drop cached data of actor taken from pool and warm it again
+	 *
+	 * @param InActor Reused actor
+	 */
+	void NotifyActorReused(AActor* InActor);
+
+	/**
+	 * Drop cached data of actor which components were added, removed or renamed
+	 *
+	 * @param InActor Changed actor
+	 */
+	void NotifyComponentsChanged(AActor* InActor);
+
+	/**
+	 * Get number of entries waiting in queue
+	 */
+	int32 GetNumPending() const
+	{
+		return Pending.Num();
+	}
+
+	/**
+	 * Get time in milliseconds spent processing queue in current frame
+	 */
+	double GetBudgetUsedMs() const
+	{
+		return BudgetUsed * 1000.0;
+	}
+
+	/**
+	 * Process queued entries until budget for current frame is spent
+	 *
+	 * @return Number of entries processed
+	 */
+	int32 ProcessPending();
+
+	/**
+	 * Process all queued entries ignoring budget, e.g. behind loading screen
+	 *
+	 * @return Number of entries processed
+	 */
+	int32 Flush();
+
+private:
+	struct FPendingResolve
+	{
+		TWeakObjectPtr<AActor> Actor;
+		// resolve function, whole actor warmup through schema and registered helpers if not bound
+		TFunction<void(AActor*)> Resolve;
+		EComponentReferenceResolvePriority Priority = EComponentReferenceResolvePriority::Normal;
+		// ordering key, higher processed first
+		float SortKey = 0.f;
+	};
+
+	void Enqueue(AActor* InActor, TFunction<void(AActor*)>&& InResolve, EComponentReferenceResolvePriority InPriority);
+	void Register(AActor* InActor, TFunction<void(AActor*)>&& InResolve);
+	void WarmupActor(AActor* InActor);
+	void SortPending();
+	int32 ProcessQueue(double InBudget, bool bGuaranteeProgress);
+	void TrackActor(AActor* InActor);
+	void HandleActorSpawned(AActor* InActor);
+	void WarmupChangedActors();
+
+	UFUNCTION()
+	void HandleActorEndPlay(AActor* InActor, EEndPlayReason::Type InReason);
+
+	// queued entries, processed from the end
+	TArray<FPendingResolve> Pending;
+	// entries were added since queue was last sorted
+	bool bPendingDirty = false;
+	// actors with queued warmup entry
+	TSet<TObjectKey<AActor>> PendingWarmups;
+	// helpers resolved with each warmup of actor
+	TMap<TObjectKey<AActor>, TArray<TFunction<void(AActor*)>>> Registered;
+	// actors with bound end play handler
+	TSet<TObjectKey<AActor>> Tracked;
+	// next element of Tracked to recheck for changed components
+	int32 RecheckCursor = 0;
+	// actors taken from cache dirty list, reused between ticks
+	TArray<AActor*> DirtyScratch;
+	// frame budget was last reset at
+	uint64 BudgetFrame = 0;
+	// seconds spent on queue in current frame
+	double BudgetUsed = 0;
+
+	FDelegateHandle ActorSpawnedHandle;
+};
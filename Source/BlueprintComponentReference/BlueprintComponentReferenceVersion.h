@@ -0,0 +1,30 @@
+// Copyright 2024, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+
+/**
+ * Custom serialization version for FBlueprintComponentReference
+ */
+struct BLUEPRINTCOMPONENTREFERENCE_API FBlueprintComponentReferenceVersion
+{
+	enum Type
+	{
+		// Before any version changes were made, references were saved as tagged properties
+		BeforeCustomVersionWasAdded = 0,
+		// References are saved as mode and name without property tags
+		CompactSerialization,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	// The GUID for this custom version number
+	static const FGuid GUID;
+
+private:
+	FBlueprintComponentReferenceVersion() = delete;
+};
@@ -1,10 +1,18 @@
 ﻿#pragma once
 
 #include "BlueprintComponentReference.h"
+#include "ResolvedComponentReferenceHandle.h"
+#include "BlueprintComponentReferenceCache.h"
 #include "Containers/Map.h"
 #include "Containers/Array.h"
+#include "Containers/Set.h"
 #include "UObject/ObjectKey.h"
 #include "Misc/CoreMiscDefines.h"
+#include "Misc/EngineVersionComparison.h"
+#include <atomic>
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+#include "UObject/ObjectPtr.h"
+#endif
 
 class AActor;
 class UActorComponent;
@@ -75,6 +83,265 @@ namespace BCRDetails
 			Collector.AddReferencedObject(InPtr, ReferencingObject);
 		}
 	};
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	/**
+	 * Strong/Strong object pointers.
+	 *
+	 * Cached pointers are reported to collector as TObjectPtr so they are visible to incremental reachability
+	 * and access tracking, reading cached value does not do serial number check as weak pointers do.
+	 */
+	struct TObjectPtrFuncs : TPointerFuncs
+	{
+		template<typename T>
+		using PtrTypeForActor = TObjectPtr<T>;
+		template<typename T>
+		using PtrTypeForComponent = TObjectPtr<T>;
+
+		static constexpr bool ExposeActor = true;
+		static constexpr bool ExposeComponent = true;
+
+		template<typename T>
+		static T* ToRawPointer(const TObjectPtr<T>& InPtr) { return InPtr.Get(); }
+		template<typename T>
+		static bool IsValidPointer(const TObjectPtr<T>& InPtr) { return ::IsValid(InPtr.Get()); }
+		template<typename T>
+		static void ExposePointer(TObjectPtr<T>& InPtr, FReferenceCollector& Collector, const UObject* ReferencingObject)
+		{
+			Collector.AddReferencedObject(InPtr, ReferencingObject);
+		}
+	};
+#endif
+
+	/**
+	 * Cached resolve result with data used to validate cache hits.
+	 *
+	 * Entry is valid while it is accessed with same actor and same source reference revision
+	 * and component generation of actor did not change since it was resolved.
+	 * Generation is read from slot of actor taken on resolve, so a hit does not look actor up.
+	 */
+	template<typename PtrType>
+	struct TCachedEntry
+	{
+		// resolved component
+		PtrType Component = nullptr;
+		// actor component was resolved in, used only for identity comparison
+		const AActor* Actor = nullptr;
+		// generation slot of actor, set while Generation is not zero
+		FActorGenerationRef ActorGeneration;
+		// component generation of actor at the time of resolve
+		uint32 Generation = 0;
+		// source reference revision at the time of resolve
+		uint32 SourceRevision = 0;
+
+		bool IsValidFor(const AActor* InActor, const FBlueprintComponentReference& InSource) const
+		{
+			return Actor == InActor
+				&& Generation != 0
+				&& Generation == ActorGeneration->Load()
+				&& SourceRevision == InSource.GetRevision();
+		}
+
+		template<typename T>
+		void Set(T* InComponent, const AActor* InActor, const FBlueprintComponentReference& InSource)
+		{
+			Component = InComponent;
+			Actor = InActor;
+			SourceRevision = InSource.GetRevision();
+			ActorGeneration = FBlueprintComponentReferenceCache::AcquireActorGeneration(InActor);
+			Generation = ActorGeneration.IsValid() ? ActorGeneration->Load() : 0;
+		}
+
+		void Reset()
+		{
+			Component = nullptr;
+			Actor = nullptr;
+			ActorGeneration.Reset();
+			Generation = 0;
+			SourceRevision = 0;
+		}
+	};
+
+	/**
+	 * State of source container that whole-container lookup was built from.
+	 *
+	 * Lookup is valid while accessed with same actor, source container size is same, no change was reported
+	 * by owning helper and component generation of actor did not change since it was filled.
+	 */
+	struct FContainerSnapshot
+	{
+		// actor components were resolved in, used only for identity comparison
+		const AActor* Actor = nullptr;
+		// number of elements in source container
+		int32 NumSource = INDEX_NONE;
+		// bumped by owning helper for every change of source container made through it or reported to it
+		uint32 SourceRevision = 0;
+		// source revision at the time lookup was filled
+		uint32 BuiltRevision = 0;
+		// generation slot of actor, set while Generation is not zero
+		FActorGenerationRef ActorGeneration;
+		// component generation of actor at the time lookup was filled
+		uint32 Generation = 0;
+
+		bool IsValidFor(const AActor* InActor, int32 InNumSource) const
+		{
+			return Actor == InActor
+				&& NumSource == InNumSource
+				&& BuiltRevision == SourceRevision
+				&& Generation != 0
+				&& Generation == ActorGeneration->Load();
+		}
+
+		void MarkSourceChanged()
+		{
+			++SourceRevision;
+		}
+
+		/** @return true if snapshot was outdated and lookup data must be rebuilt */
+		bool Update(const AActor* InActor, int32 InNumSource)
+		{
+			if (IsValidFor(InActor, InNumSource))
+			{
+				return false;
+			}
+			Actor = InActor;
+			NumSource = InNumSource;
+			BuiltRevision = SourceRevision;
+			ActorGeneration = FBlueprintComponentReferenceCache::AcquireActorGeneration(InActor);
+			Generation = ActorGeneration.IsValid() ? ActorGeneration->Load() : 0;
+			return true;
+		}
+
+		void Reset()
+		{
+			Actor = nullptr;
+			NumSource = INDEX_NONE;
+			ActorGeneration.Reset();
+			Generation = 0;
+		}
+	};
+
+	/**
+	 * Component to map key lookup storage.
+	 *
+	 * Replacing a key keeps map size, it is detected by source revision of snapshot like in TResolvedSetStorage.
+	 * Keys are stored instead of value pointers and value is found in source map on each hit,
+	 * so an unreported change can give a stale answer but never a dangling pointer.
+	 */
+	template<typename Component, typename Value>
+	struct TReverseLookupStorage : FContainerSnapshot
+	{
+		TMap<TObjectKey<Component>, FBlueprintComponentReference> Values;
+
+		void Prepare(const AActor* InActor, int32 InNumSource)
+		{
+			if (Update(InActor, InNumSource))
+			{
+				Values.Reset();
+			}
+		}
+
+		void Reset()
+		{
+			FContainerSnapshot::Reset();
+			Values.Reset();
+		}
+	};
+
+	/**
+	 * Resolved components of a reference set.
+	 *
+	 * Replacing an element keeps set size, it is detected by source revision of snapshot.
+	 */
+	template<typename Component, typename PtrType>
+	struct TResolvedSetStorage : FContainerSnapshot
+	{
+		TSet<TObjectKey<Component>> Components;
+		// resolved components, reported to collector by strong pointer traits
+		TArray<PtrType> Resolved;
+
+		bool IsValidFor(const AActor* InActor, const TSet<FBlueprintComponentReference>& InSource) const
+		{
+			return FContainerSnapshot::IsValidFor(InActor, InSource.Num());
+		}
+
+		void Update(const AActor* InActor, const TSet<FBlueprintComponentReference>& InSource)
+		{
+			FContainerSnapshot::Update(InActor, InSource.Num());
+			Components.Reset();
+			Resolved.Reset();
+		}
+
+		void Reset()
+		{
+			FContainerSnapshot::Reset();
+			Components.Reset();
+			Resolved.Reset();
+		}
+	};
+
+	/**
+	 * Resolve result shared with worker threads.
+	 *
+	 * Game thread publishes immutable record through single atomic pointer, readers do one acquire load.
+	 * Replaced records are handed to FBlueprintComponentReferenceCache and deleted after garbage collection.
+	 */
+	template<typename PtrType>
+	struct TPublishedEntry
+	{
+		// published component, reported to collector by strong pointer traits, game thread only
+		PtrType Component = nullptr;
+		// generation slot of actor published record was resolved in, game thread only
+		FActorGenerationRef ActorGeneration;
+		// source reference revision at the time of resolve, game thread only
+		uint32 SourceRevision = 0;
+		// current record, null if nothing is published
+		std::atomic<const FPublishedComponentRecord*> Record { nullptr };
+
+		TPublishedEntry() = default;
+
+		TPublishedEntry(TPublishedEntry&& Other)
+			: Component(MoveTemp(Other.Component))
+			, ActorGeneration(MoveTemp(Other.ActorGeneration))
+			, SourceRevision(Other.SourceRevision)
+			, Record(Other.Record.exchange(nullptr, std::memory_order_acq_rel))
+		{
+		}
+
+		TPublishedEntry& operator=(TPublishedEntry&& Other)
+		{
+			if (this != &Other)
+			{
+				Component = MoveTemp(Other.Component);
+				ActorGeneration = MoveTemp(Other.ActorGeneration);
+				SourceRevision = Other.SourceRevision;
+				Publish(Other.Record.exchange(nullptr, std::memory_order_acq_rel));
+			}
+			return *this;
+		}
+
+		~TPublishedEntry()
+		{
+			Publish(nullptr);
+		}
+
+		const FPublishedComponentRecord* Load() const
+		{
+			return Record.load(std::memory_order_acquire);
+		}
+
+		void Publish(const FPublishedComponentRecord* InRecord)
+		{
+			FBlueprintComponentReferenceCache::RetirePublishedRecord(Record.exchange(InRecord, std::memory_order_acq_rel));
+		}
+
+		void Reset()
+		{
+			Component = nullptr;
+			ActorGeneration.Reset();
+			SourceRevision = 0;
+			Publish(nullptr);
+		}
+	};
 
 	struct TSetKeyFuncs : DefaultKeyFuncs<FBlueprintComponentReference, false>
 	{
@@ -109,14 +376,18 @@ namespace BCRDetails
  *
  * Goal is to provide caching of resolved value and type safety for usage in code, without adding cached pointer into original reference struct.
  *
- * Data source expected to be immutable and read-only (changes only in editor at design time, no runtime modification).
- * If original data ever changes in runtime - cache must be invalidated or changes synced by accessing Storage directly.
+ * Cache entries remember actor and source reference revision they were resolved from, runtime changes of source data
+ * and components reported to FBlueprintComponentReferenceCache are detected automatically on next access.
+ * Invalidate is still available to drop cached data explicitly.
  *
  * Helpers wrap each common use:
  *
  * - TCachedComponentReference for single entry
  * - TCachedComponentReferenceArray for array entry
- * - TCachedComponentReferenceMap for map value
+ * - TCachedComponentReferenceSet for set membership
+ * - TCachedComponentReferenceMapValue for map value
+ * - TCachedComponentReferenceMapKey for map key
+ * - TConcurrentCachedComponentReference for single entry read from worker threads
  *
  * @code
  *
@@ -224,9 +495,9 @@ public:
  */
 template<typename Component, typename Traits = BCRDetails::TWeakPointerFuncs>
 class TCachedComponentReferenceSingle
-	: public TCachedComponentReferenceBase<FBlueprintComponentReference, typename Traits::template PtrTypeForComponent<Component>, Traits>
+	: public TCachedComponentReferenceBase<FBlueprintComponentReference, BCRDetails::TCachedEntry<typename Traits::template PtrTypeForComponent<Component>>, Traits>
 {
-	using Super = TCachedComponentReferenceBase<FBlueprintComponentReference, typename Traits::template PtrTypeForComponent<Component>, Traits>;
+	using Super = TCachedComponentReferenceBase<FBlueprintComponentReference, BCRDetails::TCachedEntry<typename Traits::template PtrTypeForComponent<Component>>, Traits>;
 public:
 	using StorageType = typename Super::StorageType;
 	using TargetType = typename Super::TargetType;
@@ -245,20 +516,36 @@ public:
 	{
 		static_assert(std::is_base_of_v<Component, T>, "T must be a descendant of Component");
 
-		Component* Result = Traits::ToRawPointer(this->GetStorage());
-		if (Result && Result->GetOwner() == InActor)
+		StorageType& Entry = this->GetStorage();
+		TargetType& Target = this->GetTarget();
+
+		// destroyed components are not reflected in generation until next resolve
+		Component* Result = Traits::ToRawPointer(Entry.Component);
+		if (::IsValid(Result) && Entry.IsValidFor(InActor, Target))
 		{
 			return Cast<T>(Result);
 		}
 
-		Result = this->GetTarget().template GetComponent<Component>(InActor);
-		this->GetStorage() = Result;
+		Result = Target.template GetComponent<Component>(InActor);
+		Entry.Set(Result, InActor, Target);
 		return Cast<T>(Result);
 	}
 
+	/** resolve and cache component, used for deferred resolve */
+	void GetAll(AActor* InActor)
+	{
+		this->template Get<Component>(InActor ? InActor : this->GetBaseActorPtr());
+	}
+
 	void Invalidate()
 	{
-		this->GetStorage() = nullptr;
+		this->GetStorage().Reset();
+	}
+
+	/** build precompiled handle of source reference for specified actor class */
+	FResolvedComponentReferenceHandle CompileHandle(const UClass* InClass) const
+	{
+		return FResolvedComponentReferenceHandle(this->GetTarget(), InClass);
 	}
 
 	void AddReferencedObjects(FReferenceCollector& Collector, const UObject* ReferencingObject = nullptr)
@@ -269,7 +556,7 @@ public:
 		}
 		if (Traits::ExposeComponent)
 		{
-			Traits::ExposePointer(this->GetStorage(), Collector, ReferencingObject);
+			Traits::ExposePointer(this->GetStorage().Component, Collector, ReferencingObject);
 		}
 	}
 };
@@ -301,9 +588,9 @@ using  TCachedComponentReference = TCachedComponentReferenceSingle<Component, Tr
  */
 template<typename Component, typename Traits = BCRDetails::TWeakPointerFuncs>
 class TCachedComponentReferenceArray
-	: public TCachedComponentReferenceBase<TArray<FBlueprintComponentReference>, TArray<typename Traits::template PtrTypeForComponent<Component>>, Traits>
+	: public TCachedComponentReferenceBase<TArray<FBlueprintComponentReference>, TArray<BCRDetails::TCachedEntry<typename Traits::template PtrTypeForComponent<Component>>>, Traits>
 {
-	using Super = TCachedComponentReferenceBase<TArray<FBlueprintComponentReference>, TArray<typename Traits::template PtrTypeForComponent<Component>>, Traits>;
+	using Super = TCachedComponentReferenceBase<TArray<FBlueprintComponentReference>, TArray<BCRDetails::TCachedEntry<typename Traits::template PtrTypeForComponent<Component>>>, Traits>;
 public:
 	using StorageType = typename Super::StorageType;
 	using TargetType = typename Super::TargetType;
@@ -337,15 +624,16 @@ public:
 		}
 
 		auto& ElementRef = Storage[Index];
+		const FBlueprintComponentReference& Source = Target[Index];
 
-		Component* Result = Traits::ToRawPointer(ElementRef);
-		if (Result && Result->GetOwner() == InActor)
+		Component* Result = Traits::ToRawPointer(ElementRef.Component);
+		if (::IsValid(Result) && ElementRef.IsValidFor(InActor, Source))
 		{
 			return Cast<T>(Result);
 		}
 
-		Result = Target[Index].template GetComponent<Component>(InActor);
-		ElementRef = Result;
+		Result = Source.template GetComponent<Component>(InActor);
+		ElementRef.Set(Result, InActor, Source);
 		return Cast<T>(Result);
 	}
 	
@@ -362,7 +650,7 @@ public:
 
 		for (int32 Index = 0, Num = Target.Num(); Index < Num; ++Index)
 		{
-			Storage[Index] = Target[Index].template GetComponent<Component>(InActor);
+			Storage[Index].Set(Target[Index].template GetComponent<Component>(InActor), InActor, Target[Index]);
 		}
 	}
 
@@ -371,7 +659,7 @@ public:
 	{
 		for (auto& ElementRef : this->GetStorage())
 		{
-			ElementRef = nullptr;
+			ElementRef.Reset();
 		}
 	}
 	
@@ -381,7 +669,18 @@ public:
 		StorageType& Storage = this->GetStorage();
 		if (Storage.IsValidIndex(Index))
 		{
-			Storage[Index] = nullptr;
+			Storage[Index].Reset();
+		}
+	}
+
+	/** build precompiled handles of source references for specified actor class */
+	void CompileHandles(const UClass* InClass, TArray<FResolvedComponentReferenceHandle>& OutHandles) const
+	{
+		const TargetType& Target = this->GetTarget();
+		OutHandles.Reset(Target.Num());
+		for (const FBlueprintComponentReference& Reference : Target)
+		{
+			OutHandles.Emplace(Reference, InClass);
 		}
 	}
 
@@ -405,7 +704,151 @@ public:
 		{
 			for (auto& ElementRef : this->GetStorage())
 			{
-				Traits::ExposePointer(ElementRef, Collector, ReferencingObject);
+				Traits::ExposePointer(ElementRef.Component, Collector, ReferencingObject);
+			}
+		}
+	}
+};
+
+/**
+ * EXPERIMENTAL. <br/>
+ *
+ * Templated wrapper over TSet<FBlueprintComponentReference> that answers membership queries for resolved components.
+ *
+ * Whole set is resolved once on first query, following queries are a single hash lookup,
+ * no references are resolved until set or actor components change.
+ *
+ * Elements added or removed directly are detected by set size. Replacing an element keeps size,
+ * so it has to be done through Add and Remove of helper or reported with MarkSourceChanged.
+ *
+ * @code
+ * UCLASS()
+ * class AMyActorClass : public AActor
+ * {
+ *	   GENERATED_BODY()
+ *	public:
+ *     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, AllowedClasses="/Script/Engine.SceneComponent")
+ *     TSet<FBlueprintComponentReference> WeakSpots;
+ *
+ *     TCachedComponentReferenceSet<USceneComponent> CachedWeakSpots { this, &WeakSpots };
+ * };
+ *
+ * bool bIsWeakSpot = CachedWeakSpots.Contains(HitComponent);
+ *
+ * @endcode
+ *
+ * @tparam Component Expected component type
+ * @tparam Traits Internal type traits
+ */
+template<typename Component, typename Traits = BCRDetails::TWeakPointerFuncs>
+class TCachedComponentReferenceSet
+	: public TCachedComponentReferenceBase<TSet<FBlueprintComponentReference>, BCRDetails::TResolvedSetStorage<Component, typename Traits::template PtrTypeForComponent<Component>>, Traits>
+{
+	using Super = TCachedComponentReferenceBase<TSet<FBlueprintComponentReference>, BCRDetails::TResolvedSetStorage<Component, typename Traits::template PtrTypeForComponent<Component>>, Traits>;
+public:
+	using StorageType = typename Super::StorageType;
+	using TargetType = typename Super::TargetType;
+
+	BCR_DEFAULT_CONSTRUCTORS(TCachedComponentReferenceSet)
+	BCR_MOVE_ONLY_TYPE(TCachedComponentReferenceSet)
+
+	/** test if component is referenced by set, resolving in base actor or in component owner */
+	bool Contains(const Component* InComponent)
+	{
+		AActor* SearchActor = this->GetBaseActorPtr();
+		if (!SearchActor && InComponent)
+		{
+			SearchActor = InComponent->GetOwner();
+		}
+		return this->Contains(SearchActor, InComponent);
+	}
+
+	/** test if component is referenced by set, resolving in specified actor */
+	bool Contains(AActor* InActor, const Component* InComponent)
+	{
+		if (!InActor || !InComponent)
+		{
+			return false;
+		}
+
+		StorageType& Storage = this->GetStorage();
+		if (!Storage.IsValidFor(InActor, this->GetTarget()))
+		{
+			GetAll(InActor);
+		}
+
+		return Storage.Components.Contains(InComponent);
+	}
+
+	/** add reference to source set, lookup is rebuilt on next query */
+	void Add(const FBlueprintComponentReference& InReference)
+	{
+		this->GetTarget().Add(InReference);
+		this->GetStorage().MarkSourceChanged();
+	}
+
+	/** remove reference from source set, lookup is rebuilt on next query */
+	int32 Remove(const FBlueprintComponentReference& InReference)
+	{
+		const int32 NumRemoved = this->GetTarget().Remove(InReference);
+		this->GetStorage().MarkSourceChanged();
+		return NumRemoved;
+	}
+
+	/** report change of source set made directly, required when an element was replaced keeping set size */
+	void MarkSourceChanged()
+	{
+		this->GetStorage().MarkSourceChanged();
+	}
+
+	/** resolve whole set in specified actor */
+	void GetAll(AActor* InActor)
+	{
+		if (!InActor)
+		{
+			InActor = this->GetBaseActorPtr();
+		}
+
+		TargetType& Target = this->GetTarget();
+		StorageType& Storage = this->GetStorage();
+		Storage.Update(InActor, Target);
+
+		for (const FBlueprintComponentReference& Reference : Target)
+		{
+			if (Component* Resolved = Reference.template GetComponent<Component>(InActor))
+			{
+				Storage.Components.Add(Resolved);
+				Storage.Resolved.Add(Resolved);
+			}
+		}
+	}
+
+	void Invalidate()
+	{
+		this->GetStorage().Reset();
+	}
+
+	int32 Num() const
+	{
+		return this->GetTarget().Num();
+	}
+
+	bool IsEmpty() const
+	{
+		return this->GetTarget().Num() == 0;
+	}
+
+	void AddReferencedObjects(FReferenceCollector& Collector, const UObject* ReferencingObject = nullptr)
+	{
+		if (Traits::ExposeActor)
+		{
+			Traits::ExposePointer(this->GetBaseActor(), Collector, ReferencingObject);
+		}
+		if (Traits::ExposeComponent)
+		{
+			for (auto& Resolved : this->GetStorage().Resolved)
+			{
+				Traits::ExposePointer(Resolved, Collector, ReferencingObject);
 			}
 		}
 	}
@@ -436,9 +879,9 @@ public:
  */
 template<typename Component, typename Key, typename Traits = BCRDetails::TWeakPointerFuncs>
 class TCachedComponentReferenceMapValue
-	: public TCachedComponentReferenceBase<TMap<Key, FBlueprintComponentReference>, TMap<Key, typename Traits::template PtrTypeForComponent<Component>>, Traits>
+	: public TCachedComponentReferenceBase<TMap<Key, FBlueprintComponentReference>, TMap<Key, BCRDetails::TCachedEntry<typename Traits::template PtrTypeForComponent<Component>>>, Traits>
 {
-	using Super = TCachedComponentReferenceBase<TMap<Key, FBlueprintComponentReference>, TMap<Key, typename Traits::template PtrTypeForComponent<Component>>, Traits>;
+	using Super = TCachedComponentReferenceBase<TMap<Key, FBlueprintComponentReference>, TMap<Key, BCRDetails::TCachedEntry<typename Traits::template PtrTypeForComponent<Component>>>, Traits>;
 public:
 	using StorageType = typename Super::StorageType;
     using TargetType = typename Super::TargetType;
@@ -460,26 +903,38 @@ public:
 		TargetType& Target = this->GetTarget();
 		StorageType& Storage = this->GetStorage();
 
-		auto& ElementRef = Storage.FindOrAdd(InKey, {});
+		const FBlueprintComponentReference* Ref = Target.Find(InKey);
+		if (!Ref)
+		{
+			Storage.Remove(InKey);
+			return nullptr;
+		}
+
+		auto& ElementRef = Storage.FindOrAdd(InKey);
 
-		Component* Result = Traits::ToRawPointer(ElementRef);
-		if (Result && Result->GetOwner() == InActor)
+		Component* Result = Traits::ToRawPointer(ElementRef.Component);
+		if (::IsValid(Result) && ElementRef.IsValidFor(InActor, *Ref))
 		{
 			return Cast<T>(Result);
 		}
 
-		if (const FBlueprintComponentReference* Ref = Target.Find(InKey))
+		Result = Ref->template GetComponent<Component>(InActor);
+		ElementRef.Set(Result, InActor, *Ref);
+
+		return Cast<T>(Result);
+	}
+
+	void GetAll(AActor* InActor)
+	{
+		if (!InActor)
 		{
-			Result = Ref->GetComponent<Component>(InActor);
-			ElementRef = Result;
+			InActor = this->GetBaseActorPtr();
 		}
-		else
+
+		for (auto& RefToValue : this->GetTarget())
 		{
-			Result = nullptr;
-			ElementRef = nullptr;
+			this->template Get<Component>(InActor, RefToValue.Key);
 		}
-
-		return Cast<T>(Result);
 	}
 
 	void Invalidate()
@@ -497,7 +952,7 @@ public:
 		{
 			for (auto& ElementRef : this->GetStorage())
 			{
-				Traits::ExposePointer(ElementRef.Value, Collector, ReferencingObject);
+				Traits::ExposePointer(ElementRef.Value.Component, Collector, ReferencingObject);
 			}
 		}
 	}
@@ -510,6 +965,9 @@ public:
  * Templated wrapper over TMap<FBlueprintComponentReference, TValue> that stores pointers to resolved objects.
  *
  * This version always using TObjectKey for internal storage key.
+ *
+ * Keys added or removed directly are detected by map size. Replacing a key keeps size,
+ * so it has to be done through Add and Remove of helper or reported with MarkSourceChanged.
  * 
  * @code
  * UCLASS()
@@ -531,9 +989,9 @@ public:
  */
 template<typename Component, typename Value, typename Traits = BCRDetails::TWeakPointerFuncs>
 class TCachedComponentReferenceMapKey
-	: public TCachedComponentReferenceBase<TMap<FBlueprintComponentReference, Value>, TMap<TObjectKey<Component>, Value*>, Traits>
+	: public TCachedComponentReferenceBase<TMap<FBlueprintComponentReference, Value>, BCRDetails::TReverseLookupStorage<Component, Value>, Traits>
 {
-	using Super = TCachedComponentReferenceBase<TMap<FBlueprintComponentReference, Value>, TMap<TObjectKey<Component>, Value*>, Traits>;
+	using Super = TCachedComponentReferenceBase<TMap<FBlueprintComponentReference, Value>, BCRDetails::TReverseLookupStorage<Component, Value>, Traits>;
 public:
 	using StorageType = typename Super::StorageType;
 	using TargetType = typename Super::TargetType;
@@ -559,6 +1017,7 @@ public:
 		
 		TargetType& Target = this->GetTarget();
 		StorageType& Storage = this->GetStorage();
+		Storage.Prepare(InActor, Target.Num());
 
 		// if Storage is Ptr->BCR 
 		// cache hit would require to do lookup to ensure taking appropriate data from target
@@ -571,19 +1030,20 @@ public:
 		// cache miss will require resolve loop
 		Value* FoundValue = nullptr;
 
-		const auto* StoragePtr = Storage.Find(InKey);
-		if (StoragePtr != nullptr)
+		const FBlueprintComponentReference* StorageKey = Storage.Values.Find(InKey);
+		if (StorageKey != nullptr)
 		{
-			FoundValue = *StoragePtr;// Target.Find(*StoragePtr);
+			FoundValue = Target.Find(*StorageKey);
 		}
-		else
+
+		if (FoundValue == nullptr)
 		{    // if nothing found the only way is to do loop and find our component
 			for (auto& RefToValue : Target)
 			{
 				const FBlueprintComponentReference& Ref = RefToValue.Key;
 				if (Ref.GetComponent<Component>(InActor) == InKey)
 				{
-					Storage.Add(InKey, &RefToValue.Value);
+					Storage.Values.Add(InKey, Ref);
 
 					FoundValue = &RefToValue.Value;
 					break;
@@ -603,17 +1063,38 @@ public:
 		
 		TargetType& Target = this->GetTarget();
 		StorageType& Storage = this->GetStorage();
+		Storage.Prepare(InActor, Target.Num());
 
 		for (auto& RefToValue : Target)
 		{
 			Component* Resolved = RefToValue.Key.template GetComponent<Component>(InActor);
 			if (Resolved)
 			{
-			     Storage.Add(Resolved, &RefToValue.Value);
+			     Storage.Values.Add(Resolved, RefToValue.Key);
 			}
 		}
 	}
 
+	/** add entry to source map, lookup is rebuilt on next query */
+	Value& Add(const FBlueprintComponentReference& InKey, const Value& InValue)
+	{
+		this->GetStorage().MarkSourceChanged();
+		return this->GetTarget().Add(InKey, InValue);
+	}
+
+	/** remove entry from source map, lookup is rebuilt on next query */
+	int32 Remove(const FBlueprintComponentReference& InKey)
+	{
+		this->GetStorage().MarkSourceChanged();
+		return this->GetTarget().Remove(InKey);
+	}
+
+	/** report change of source map made directly, required when a key was replaced keeping map size */
+	void MarkSourceChanged()
+	{
+		this->GetStorage().MarkSourceChanged();
+	}
+
 	void Invalidate()
 	{
 		this->GetStorage().Reset();
@@ -628,3 +1109,124 @@ public:
 		}
 	}
 };
+
+/**
+ * EXPERIMENTAL. <br/>
+ *
+ * Single entry cache that can be read from worker threads (async animation, physics and other tasks).
+ *
+ * Resolution stays on game thread: Get on game thread validates cached value and resolves it when needed,
+ * resolved component and component generation are then published together as one immutable record.
+ * Readers on other threads never resolve and never lock, they do a single acquire load of the record
+ * and get its component only if it is still alive, otherwise null.
+ *
+ * Records are held by weak pointer regardless of traits, replaced records are deleted after garbage collection,
+ * so readers must not run concurrently with garbage collection, which holds for tasks that complete within a frame.
+ *
+ * @code
+ *     TConcurrentCachedComponentReference<USceneComponent> CachedTarget { this, &TargetComponent };
+ *
+ *     // game thread, e.g. in Tick
+ *     CachedTarget.Get();
+ *     // worker thread
+ *     if (USceneComponent* Target = CachedTarget.GetPublished()) { ... }
+ * @endcode
+ *
+ * @tparam Component Expected component type
+ * @tparam Traits Internal traits type
+ */
+template<typename Component, typename Traits = BCRDetails::TWeakPointerFuncs>
+class TConcurrentCachedComponentReference
+	: public TCachedComponentReferenceBase<FBlueprintComponentReference, BCRDetails::TPublishedEntry<typename Traits::template PtrTypeForComponent<Component>>, Traits>
+{
+	using Super = TCachedComponentReferenceBase<FBlueprintComponentReference, BCRDetails::TPublishedEntry<typename Traits::template PtrTypeForComponent<Component>>, Traits>;
+public:
+	using StorageType = typename Super::StorageType;
+	using TargetType = typename Super::TargetType;
+
+	BCR_DEFAULT_CONSTRUCTORS(TConcurrentCachedComponentReference)
+	BCR_MOVE_ONLY_TYPE(TConcurrentCachedComponentReference)
+
+	/**
+	 * Get component from any thread.
+	 *
+	 * On game thread resolves and publishes value if cached one is outdated.
+	 */
+	Component* Get()
+	{
+		if (!IsInGameThread())
+		{
+			return GetPublished();
+		}
+
+		StorageType& Entry = this->GetStorage();
+		const FPublishedComponentRecord* Record = Entry.Load();
+		// record is published only with a generation slot
+		if (Record
+			&& Record->Generation == Entry.ActorGeneration->Load()
+			&& Entry.SourceRevision == this->GetTarget().GetRevision())
+		{
+			if (UActorComponent* Result = Record->Component.Get())
+			{
+				return static_cast<Component*>(Result);
+			}
+		}
+
+		return Resolve();
+	}
+
+	/**
+	 * Get published component, safe to call from any thread.
+	 *
+	 * @return Component published by last game thread access or null if none or it was destroyed since
+	 */
+	Component* GetPublished() const
+	{
+		const FPublishedComponentRecord* Record = this->GetStorage().Load();
+		return Record ? static_cast<Component*>(Record->Component.Get()) : nullptr;
+	}
+
+	/**
+	 * Resolve component and publish it, game thread only
+	 */
+	Component* Resolve()
+	{
+		check(IsInGameThread());
+
+		AActor* const SearchActor = this->GetBaseActorPtr();
+		StorageType& Entry = this->GetStorage();
+		TargetType& Target = this->GetTarget();
+
+		Component* Result = Target.template GetComponent<Component>(SearchActor);
+		FActorGenerationRef ActorGeneration = FBlueprintComponentReferenceCache::AcquireActorGeneration(SearchActor);
+		const uint32 Generation = ActorGeneration.IsValid() ? ActorGeneration->Load() : 0;
+
+		Entry.Component = Result;
+		Entry.ActorGeneration = MoveTemp(ActorGeneration);
+		Entry.SourceRevision = Target.GetRevision();
+		Entry.Publish(Generation != 0 ? new FPublishedComponentRecord { Result, Generation } : nullptr);
+		return Result;
+	}
+
+	/**
+	 * Drop published value, game thread only
+	 */
+	void Invalidate()
+	{
+		check(IsInGameThread());
+
+		this->GetStorage().Reset();
+	}
+
+	void AddReferencedObjects(FReferenceCollector& Collector, const UObject* ReferencingObject = nullptr)
+	{
+		if (Traits::ExposeActor)
+		{
+			Traits::ExposePointer(this->GetBaseActor(), Collector, ReferencingObject);
+		}
+		if (Traits::ExposeComponent)
+		{
+			Traits::ExposePointer(this->GetStorage().Component, Collector, ReferencingObject);
+		}
+	}
+};
@@ -0,0 +1,58 @@
+// Copyright 2024, Aquanox.
+
+#include "ComponentReferenceLiteral.h"
+#include "BlueprintComponentReferenceCache.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/Class.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogComponentReferenceLiteral, Log, All);
+
+namespace BCRLiteral
+{
+	// function local to not depend on static initialization order of declaring modules
+	inline FCriticalSection& GetLock()
+	{
+		static FCriticalSection Lock;
+		return Lock;
+	}
+
+	inline TArray<FComponentReferenceLiterals::FDeclaration>& GetDeclarations()
+	{
+		static TArray<FComponentReferenceLiterals::FDeclaration> Declarations;
+		return Declarations;
+	}
+}
+
+void FComponentReferenceLiterals::Register(const FDeclaration& InDeclaration)
+{
+	FScopeLock Lock(&BCRLiteral::GetLock());
+	BCRLiteral::GetDeclarations().Add(InDeclaration);
+}
+
+int32 FComponentReferenceLiterals::ValidateAll()
+{
+	TArray<FDeclaration> Declarations;
+	{
+		FScopeLock Lock(&BCRLiteral::GetLock());
+		Declarations = BCRLiteral::GetDeclarations();
+	}
+
+	int32 NumInvalid = 0;
+	for (const FDeclaration& Declaration : Declarations)
+	{
+		const UClass* ActorClass = Declaration.GetClass();
+		const FBlueprintComponentReference& Reference = Declaration.GetReference();
+		if (!IsValidFor(Reference, ActorClass))
+		{
+			UE_LOG(LogComponentReferenceLiteral, Warning, TEXT("Component reference literal %s declared at %s:%d can not be resolved in %s"),
+				*Reference.ToString(), ANSI_TO_TCHAR(Declaration.File), Declaration.Line, *GetNameSafe(ActorClass));
+			++NumInvalid;
+		}
+	}
+	return NumInvalid;
+}
+
+bool FComponentReferenceLiterals::IsValidFor(const FBlueprintComponentReference& InReference, const UClass* InActorClass)
+{
+	return FBlueprintComponentReferenceCache::CanResolveInClass(InReference, InActorClass);
+}
@@ -0,0 +1,117 @@
+// Copyright 2024, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintComponentReference.h"
+
+class UClass;
+
+/**
+ * Registry of component reference literals declared with BCR_DECLARE_PROPERTY_LITERAL / BCR_DECLARE_PATH_LITERAL.
+ *
+ * Declared literals remember actor class they are meant for and are checked against it once engine is initialized,
+ * so a renamed or removed component is reported at startup instead of silently resolving to null.
+ */
+class BLUEPRINTCOMPONENTREFERENCE_API FComponentReferenceLiterals
+{
+public:
+	struct FDeclaration
+	{
+		/** Actor class getter, classes are not constructed yet when declarations are registered */
+		UClass* (*GetClass)() = nullptr;
+		/** Literal getter */
+		const FBlueprintComponentReference& (*GetReference)() = nullptr;
+		/** Declaration site */
+		const ANSICHAR* File = nullptr;
+		int32 Line = 0;
+	};
+
+	/**
+	 * Add declared literal to validation list
+	 */
+	static void Register(const FDeclaration& InDeclaration);
+
+	/**
+	 * Check every declared literal against its actor class, invalid ones are logged as warnings
+	 *
+	 * @return Number of invalid literals
+	 */
+	static int32 ValidateAll();
+
+	/**
+	 * Check reference can be resolved in instances of actor class, see FBlueprintComponentReferenceCache::CanResolveInClass
+	 *
+	 * @param InReference Reference to check
+	 * @param InActorClass Actor class
+	 * @return True if reference can point to a component of that class
+	 */
+	static bool IsValidFor(const FBlueprintComponentReference& InReference, const UClass* InActorClass);
+};
+
+/** Registers declared literal during static initialization */
+struct FComponentReferenceLiteralRegistrar
+{
+	explicit FComponentReferenceLiteralRegistrar(const FComponentReferenceLiterals::FDeclaration& InDeclaration)
+	{
+		FComponentReferenceLiterals::Register(InDeclaration);
+	}
+};
+
+#define BCR_LITERAL_IMPL(InMode, InValue) \
+	([]() -> const FBlueprintComponentReference& \
+	{ \
+		static const FBlueprintComponentReference Literal(InMode, FName(TEXT(InValue))); \
+		return Literal; \
+	}())
+
+/**
+ * Property mode reference literal. Value name is created once per use site, following evaluations return the same instance.
+ *
+ * @code
+ *	UActorComponent* Mesh = BCR_PROPERTY_LITERAL("Mesh").GetComponent(Actor);
+ * @endcode
+ */
+#define BCR_PROPERTY_LITERAL(InName) BCR_LITERAL_IMPL(EBlueprintComponentReferenceMode::Property, InName)
+
+/**
+ * Path mode reference literal. Value name is created once per use site, following evaluations return the same instance.
+ */
+#define BCR_PATH_LITERAL(InPath) BCR_LITERAL_IMPL(EBlueprintComponentReferenceMode::Path, InPath)
+
+/**
+ * Nested mode reference literal. Value name is created once per use site, following evaluations return the same instance.
+ */
+#define BCR_NESTED_LITERAL(InPath) BCR_LITERAL_IMPL(EBlueprintComponentReferenceMode::Nested, InPath)
+
+#define BCR_DECLARE_LITERAL_IMPL(InIdent, InActorClass, InMode, InValue) \
+	static const FBlueprintComponentReference& InIdent() \
+	{ \
+		static const FBlueprintComponentReference Literal(InMode, FName(TEXT(InValue))); \
+		return Literal; \
+	} \
+	static const FComponentReferenceLiteralRegistrar InIdent##_Registrar({ &InActorClass::StaticClass, &InIdent, __FILE__, __LINE__ })
+
+/**
+ * Declare Property mode reference literal at file scope, checked against actor class at startup.
+ *
+ * @code
+ *	BCR_DECLARE_PROPERTY_LITERAL(MeshReference, ACharacter, "Mesh");
+ *
+ *	UActorComponent* Mesh = MeshReference().GetComponent(Actor);
+ * @endcode
+ */
+#define BCR_DECLARE_PROPERTY_LITERAL(InIdent, InActorClass, InName) \
+	BCR_DECLARE_LITERAL_IMPL(InIdent, InActorClass, EBlueprintComponentReferenceMode::Property, InName)
+
+/**
+ * Declare Path mode reference literal at file scope, checked against actor class at startup.
+ */
+#define BCR_DECLARE_PATH_LITERAL(InIdent, InActorClass, InPath) \
+	BCR_DECLARE_LITERAL_IMPL(InIdent, InActorClass, EBlueprintComponentReferenceMode::Path, InPath)
+
+/**
+ * Declare Nested mode reference literal at file scope, checked against actor class at startup.
+ */
+#define BCR_DECLARE_NESTED_LITERAL(InIdent, InActorClass, InPath) \
+	BCR_DECLARE_LITERAL_IMPL(InIdent, InActorClass, EBlueprintComponentReferenceMode::Nested, InPath)
@@ -0,0 +1,288 @@
+// Copyright 2024, Aquanox.
+
+#include "ComponentReferenceSchema.h"
+#include "BlueprintComponentReference.h"
+#include "BlueprintComponentReferenceCache.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UnrealType.h"
+
+namespace BCRSchema
+{
+	// containers of structs nested deeper than this are not described
+	constexpr int32 MaxDepth = 8;
+
+	static FRWLock SchemaLock;
+	static TMap<TObjectKey<UStruct>, FComponentReferenceSchema::FSchemaPtr> Schemas;
+	static uint32 SchemaGeneration = 0;
+
+	static const FComponentReferenceSchema::FSchemaPtr EmptySchema = MakeShared<FComponentReferenceSchema, ESPMode::ThreadSafe>();
+
+	inline bool IsReferenceStruct(const UStruct* InStruct)
+	{
+		return InStruct && InStruct->IsChildOf(FBlueprintComponentReference::StaticStruct());
+	}
+
+	/** Walk references stored in container of schema type, visitor receives declaring field and reference */
+	template<typename VisitorType>
+	void VisitReferences(const FComponentReferenceSchema& InSchema, const void* InContainer, VisitorType& Visitor)
+	{
+		if (!InContainer)
+		{
+			return;
+		}
+
+		using FEntry = FComponentReferenceSchema::FEntry;
+		using EEntryKind = FComponentReferenceSchema::EEntryKind;
+
+		auto VisitElement = [&Visitor](const FEntry& InEntry, const void* InElement)
+		{
+			if (InEntry.ElementSchema.IsValid())
+			{
+				VisitReferences(*InEntry.ElementSchema, InElement, Visitor);
+			}
+			else
+			{
+				Visitor(InEntry.Property, *static_cast<const FBlueprintComponentReference*>(InElement));
+			}
+		};
+
+		for (const FEntry& Entry : InSchema.GetEntries())
+		{
+			const void* ValuePtr = static_cast<const uint8*>(InContainer) + Entry.Offset;
+
+			switch (Entry.Kind)
+			{
+			case EEntryKind::Value:
+				Visitor(Entry.Property, *static_cast<const FBlueprintComponentReference*>(ValuePtr));
+				break;
+			case EEntryKind::Array:
+			{
+				FScriptArrayHelper Helper(static_cast<const FArrayProperty*>(Entry.Property), ValuePtr);
+				for (int32 Index = 0; Index < Helper.Num(); ++Index)
+				{
+					VisitElement(Entry, Helper.GetRawPtr(Index));
+				}
+				break;
+			}
+			case EEntryKind::Set:
+			{
+				FScriptSetHelper Helper(static_cast<const FSetProperty*>(Entry.Property), ValuePtr);
+				for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+				{
+					if (Helper.IsValidIndex(Index))
+					{
+						VisitElement(Entry, Helper.GetElementPtr(Index));
+					}
+				}
+				break;
+			}
+			case EEntryKind::MapKey:
+			case EEntryKind::MapValue:
+			{
+				FScriptMapHelper Helper(static_cast<const FMapProperty*>(Entry.Property), ValuePtr);
+				for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+				{
+					if (Helper.IsValidIndex(Index))
+					{
+						VisitElement(Entry, Entry.Kind == EEntryKind::MapKey ? Helper.GetKeyPtr(Index) : Helper.GetValuePtr(Index));
+					}
+				}
+				break;
+			}
+			}
+		}
+	}
+}
+
+FComponentReferenceSchema::FSchemaPtr FComponentReferenceSchema::Get(const UStruct* InStruct)
+{
+	if (!InStruct)
+	{
+		return BCRSchema::EmptySchema;
+	}
+
+	const uint32 Generation = FBlueprintComponentReferenceCache::GetGeneration();
+
+	{
+		FReadScopeLock ReadLock(BCRSchema::SchemaLock);
+		if (BCRSchema::SchemaGeneration == Generation)
+		{
+			if (const FSchemaPtr* Existing = BCRSchema::Schemas.Find(InStruct))
+			{
+				return *Existing;
+			}
+		}
+	}
+
+	FSchemaPtr Schema = Build(InStruct, 0);
+
+	{
+		FWriteScopeLock WriteLock(BCRSchema::SchemaLock);
+		if (BCRSchema::SchemaGeneration != Generation)
+		{ // layouts may have changed since schemas were built
+			BCRSchema::Schemas.Reset();
+			BCRSchema::SchemaGeneration = Generation;
+		}
+		BCRSchema::Schemas.Add(InStruct, Schema);
+	}
+
+	return Schema;
+}
+
+void FComponentReferenceSchema::PruneStaleEntries()
+{
+	FWriteScopeLock WriteLock(BCRSchema::SchemaLock);
+	for (auto It = BCRSchema::Schemas.CreateIterator(); It; ++It)
+	{
+		if (It->Key.ResolveObjectPtr() == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+FComponentReferenceSchema::FSchemaPtr FComponentReferenceSchema::Build(const UStruct* InStruct, int32 Depth)
+{
+	TSharedRef<FComponentReferenceSchema, ESPMode::ThreadSafe> Schema = MakeShared<FComponentReferenceSchema, ESPMode::ThreadSafe>();
+	Schema->AddStructFields(InStruct, 0, Depth);
+	Schema->Entries.Shrink();
+	return Schema->IsEmpty() ? BCRSchema::EmptySchema : FSchemaPtr(Schema);
+}
+
+void FComponentReferenceSchema::AddStructFields(const UStruct* InStruct, int32 InBaseOffset, int32 Depth)
+{
+	for (TFieldIterator<FProperty> It(InStruct); It; ++It)
+	{
+		const FProperty* Property = *It;
+
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+		const int32 ElementSize = Property->ElementSize;
+#else
+		const int32 ElementSize = Property->GetElementSize();
+#endif
+		for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ++ArrayIndex)
+		{
+			const int32 Offset = InBaseOffset + Property->GetOffset_ForInternal() + ElementSize * ArrayIndex;
+			if (!AddField(Property, Offset, Depth))
+			{ // nothing to describe in this field
+				break;
+			}
+		}
+	}
+}
+
+bool FComponentReferenceSchema::AddField(const FProperty* InProperty, int32 InOffset, int32 Depth)
+{
+	auto DescribeElement = [Depth](const FProperty* InElement, FSchemaPtr& OutSchema) -> bool
+	{
+		const FStructProperty* AsStruct = CastField<FStructProperty>(InElement);
+		if (!AsStruct || Depth >= BCRSchema::MaxDepth)
+		{
+			return false;
+		}
+		if (BCRSchema::IsReferenceStruct(AsStruct->Struct))
+		{
+			return true;
+		}
+		OutSchema = Build(AsStruct->Struct, Depth + 1);
+		return !OutSchema->IsEmpty();
+	};
+
+	if (const FStructProperty* AsStruct = CastField<FStructProperty>(InProperty))
+	{
+		if (BCRSchema::IsReferenceStruct(AsStruct->Struct))
+		{
+			Entries.Add({ InProperty, InOffset, EEntryKind::Value, nullptr });
+			return true;
+		}
+
+		const int32 NumBefore = Entries.Num();
+		AddStructFields(AsStruct->Struct, InOffset, Depth);
+		return Entries.Num() != NumBefore;
+	}
+
+	FSchemaPtr ElementSchema;
+	if (const FArrayProperty* AsArray = CastField<FArrayProperty>(InProperty))
+	{
+		if (DescribeElement(AsArray->Inner, ElementSchema))
+		{
+			Entries.Add({ InProperty, InOffset, EEntryKind::Array, ElementSchema });
+			return true;
+		}
+	}
+	else if (const FSetProperty* AsSet = CastField<FSetProperty>(InProperty))
+	{
+		if (DescribeElement(AsSet->ElementProp, ElementSchema))
+		{
+			Entries.Add({ InProperty, InOffset, EEntryKind::Set, ElementSchema });
+			return true;
+		}
+	}
+	else if (const FMapProperty* AsMap = CastField<FMapProperty>(InProperty))
+	{
+		bool bAdded = false;
+		if (DescribeElement(AsMap->KeyProp, ElementSchema))
+		{
+			Entries.Add({ InProperty, InOffset, EEntryKind::MapKey, ElementSchema });
+			bAdded = true;
+		}
+		ElementSchema.Reset();
+		if (DescribeElement(AsMap->ValueProp, ElementSchema))
+		{
+			Entries.Add({ InProperty, InOffset, EEntryKind::MapValue, ElementSchema });
+			bAdded = true;
+		}
+		return bAdded;
+	}
+
+	return false;
+}
+
+void FComponentReferenceSchema::ForEachReference(const void* InContainer, TFunctionRef<void(const FBlueprintComponentReference&)> Visitor) const
+{
+	auto VisitReference = [&Visitor](const FProperty*, const FBlueprintComponentReference& InReference)
+	{
+		Visitor(InReference);
+	};
+	BCRSchema::VisitReferences(*this, InContainer, VisitReference);
+}
+
+void FComponentReferenceSchema::ForEachReferenceField(const void* InContainer, TFunctionRef<void(const FProperty*, const FBlueprintComponentReference&)> Visitor) const
+{
+	BCRSchema::VisitReferences(*this, InContainer, Visitor);
+}
+
+int32 FComponentReferenceSchema::Resolve(const void* InContainer, const AActor* InActor, TArray<UActorComponent*>& OutComponents) const
+{
+	OutComponents.Reset();
+
+	int32 NumResolved = 0;
+	ForEachReference(InContainer, [InActor, &OutComponents, &NumResolved](const FBlueprintComponentReference& InReference)
+	{
+		UActorComponent* Component = InReference.GetComponent(InActor);
+		NumResolved += Component != nullptr;
+		OutComponents.Add(Component);
+	});
+
+	return NumResolved;
+}
+
+int32 FComponentReferenceSchema::WarmupActor(const AActor* InActor)
+{
+	if (!InActor)
+	{
+		return 0;
+	}
+
+	int32 NumResolved = 0;
+	Get(InActor->GetClass())->ForEachReference(InActor, [InActor, &NumResolved](const FBlueprintComponentReference& InReference)
+	{
+		NumResolved += InReference.GetComponent(InActor) != nullptr;
+	});
+
+	return NumResolved;
+}
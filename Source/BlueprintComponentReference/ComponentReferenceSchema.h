@@ -0,0 +1,138 @@
+// Copyright 2024, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+
+struct FBlueprintComponentReference;
+class AActor;
+class UActorComponent;
+class UStruct;
+class FProperty;
+
+/**
+ * Layout of component reference fields within a class or struct.
+ *
+ * Built once per type by walking reflected properties, including nested structs and
+ * array, set and map containers, and reused for every instance of that type.
+ * Visiting every reference of an object is a linear pass over stored offsets without field iteration.
+ *
+ * Every reference field is described, including fields picked for another actor class with ActorClass metadata:
+ * metadata is stripped from cooked builds, so schema does not depend on it and is same in editor and cooked game.
+ * Resolving such fields in owning actor yields null and costs a failed lookup.
+ *
+ * Schemas are dropped together with resolution plans when classes are reinstanced.
+ *
+ * @code
+ *	TArray<UActorComponent*> Components;
+ *	FComponentReferenceSchema::Get(MyActor->GetClass())->Resolve(MyActor, MyActor, Components);
+ * @endcode
+ */
+class BLUEPRINTCOMPONENTREFERENCE_API FComponentReferenceSchema
+{
+public:
+	using FSchemaPtr = TSharedPtr<const FComponentReferenceSchema, ESPMode::ThreadSafe>;
+
+	enum class EEntryKind : uint8
+	{
+		/** Reference field, nested struct fields are flattened into owner */
+		Value,
+		/** Array of references or of structs containing references */
+		Array,
+		/** Set of references or of structs containing references */
+		Set,
+		/** Map with reference or struct keys */
+		MapKey,
+		/** Map with reference or struct values */
+		MapValue,
+	};
+
+	struct FEntry
+	{
+		/** Field or container property */
+		const FProperty* Property = nullptr;
+		/** Offset of value from start of schema owner */
+		int32 Offset = 0;
+		/** Entry type */
+		EEntryKind Kind = EEntryKind::Value;
+		/** Layout of container element if element is a struct containing references, null if element is a reference */
+		FSchemaPtr ElementSchema;
+	};
+
+	/**
+	 * Find or build schema for type
+	 *
+	 * @param InStruct Class or struct to describe
+	 * @return Schema, empty if type has no component references
+	 */
+	static FSchemaPtr Get(const UStruct* InStruct);
+
+	/**
+	 * Drop schemas of destroyed types
+	 */
+	static void PruneStaleEntries();
+
+	/**
+	 * Does type have any reference fields
+	 */
+	bool IsEmpty() const
+	{
+		return Entries.Num() == 0;
+	}
+
+	/**
+	 * Get schema entries
+	 */
+	const TArray<FEntry>& GetEntries() const
+	{
+		return Entries;
+	}
+
+	/**
+	 * Invoke visitor for each component reference stored in object of schema type
+	 *
+	 * @param InContainer Object or struct memory
+	 * @param Visitor Function to invoke
+	 */
+	void ForEachReference(const void* InContainer, TFunctionRef<void(const FBlueprintComponentReference&)> Visitor) const;
+
+	/**
+	 * Invoke visitor for each component reference stored in object of schema type, along with field that declares it:
+	 * reference property itself, or container property for references stored directly in a container
+	 *
+	 * @param InContainer Object or struct memory
+	 * @param Visitor Function to invoke
+	 */
+	void ForEachReferenceField(const void* InContainer, TFunctionRef<void(const FProperty* /* field */, const FBlueprintComponentReference&)> Visitor) const;
+
+	/**
+	 * Resolve every component reference stored in object of schema type
+	 *
+	 * Output storage is reused, results are in visit order and contain null for unresolved references.
+	 *
+	 * @param InContainer Object or struct memory
+	 * @param InActor Actor to resolve references in
+	 * @param OutComponents Resolved components
+	 * @return Number of resolved components
+	 */
+	int32 Resolve(const void* InContainer, const AActor* InActor, TArray<UActorComponent*>& OutComponents) const;
+
+	/**
+	 * Resolve every component reference declared by actor class in that actor.
+	 *
+	 * Primes property plans and component name index of the actor, used as warmup after spawn.
+	 *
+	 * @param InActor Actor to warm
+	 * @return Number of resolved components
+	 */
+	static int32 WarmupActor(const AActor* InActor);
+
+private:
+	static FSchemaPtr Build(const UStruct* InStruct, int32 Depth);
+
+	void AddStructFields(const UStruct* InStruct, int32 InBaseOffset, int32 Depth);
+	bool AddField(const FProperty* InProperty, int32 InOffset, int32 Depth);
+
+	TArray<FEntry> Entries;
+};
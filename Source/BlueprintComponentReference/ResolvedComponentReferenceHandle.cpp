@@ -0,0 +1,51 @@
+// Copyright 2024, Aquanox.
+
+#include "ResolvedComponentReferenceHandle.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+
+FResolvedComponentReferenceHandle::FResolvedComponentReferenceHandle(const FBlueprintComponentReference& InReference, const UClass* InClass)
+	: Reference(InReference)
+{
+	Compile(InClass);
+}
+
+void FResolvedComponentReferenceHandle::Compile(const UClass* InClass)
+{
+	Plan = FComponentReferencePlan();
+	CompiledClass = InClass;
+	Generation = FBlueprintComponentReferenceCache::GetGeneration();
+
+	if (InClass && Reference.GetMode() == EBlueprintComponentReferenceMode::Property)
+	{
+		Plan = FBlueprintComponentReferenceCache::FindPlan(InClass, Reference.GetValue());
+	}
+}
+
+UActorComponent* FResolvedComponentReferenceHandle::GetComponent(const AActor* SearchActor) const
+{
+	if (!SearchActor)
+	{
+		return nullptr;
+	}
+
+	switch (Reference.GetMode())
+	{
+	case EBlueprintComponentReferenceMode::Property:
+		if (IsCompiledFor(SearchActor->GetClass()))
+		{
+			return Cast<UActorComponent>(Plan.Resolve(SearchActor));
+		}
+		break;
+	case EBlueprintComponentReferenceMode::Path:
+		return FBlueprintComponentReferenceCache::FindComponentByName(SearchActor, Reference.GetValue());
+	case EBlueprintComponentReferenceMode::Nested:
+		return FBlueprintComponentReferenceCache::FindNestedComponent(SearchActor, Reference.GetValue());
+	case EBlueprintComponentReferenceMode::Dynamic:
+		return FBlueprintComponentReferenceCache::FindDynamicComponent(SearchActor, Reference.GetValue());
+	default:
+		return nullptr;
+	}
+
+	return Reference.GetComponent(SearchActor);
+}
@@ -0,0 +1,104 @@
+// Copyright 2024, Aquanox.
+
+#pragma once
+
+#include "BlueprintComponentReference.h"
+#include "BlueprintComponentReferenceCache.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class AActor;
+class UClass;
+class UActorComponent;
+
+/**
+ * Precompiled form of FBlueprintComponentReference bound to a specific actor class.
+ *
+ * Resolving an actor of compiled class is a class identity check followed by a raw load at the property offset
+ * (Property mode) or a subobject lookup by name (Path mode).
+ * Actors of other classes, or handles compiled before class reinstancing, fall back to the source reference.
+ *
+ * @code
+ *	FResolvedComponentReferenceHandle Handle(MyReference, AMyPawn::StaticClass());
+ *	for (AMyPawn* Pawn : SpawnedPawns)
+ *	{
+ *		USceneComponent* Target = Handle.GetComponent<USceneComponent>(Pawn);
+ *	}
+ * @endcode
+ */
+struct BLUEPRINTCOMPONENTREFERENCE_API FResolvedComponentReferenceHandle
+{
+public:
+	/**
+	 * Default constructor, produces handle that resolves nothing
+	 */
+	FResolvedComponentReferenceHandle() = default;
+
+	/**
+	 * Compile reference for specified actor class
+	 *
+	 * @param InReference Source reference
+	 * @param InClass Actor class to compile against
+	 */
+	FResolvedComponentReferenceHandle(const FBlueprintComponentReference& InReference, const UClass* InClass);
+
+	/**
+	 * Rebuild handle against new actor class
+	 */
+	void Compile(const UClass* InClass);
+
+	/**
+	 * Get source reference
+	 */
+	const FBlueprintComponentReference& GetReference() const
+	{
+		return Reference;
+	}
+
+	/**
+	 * Get class handle was compiled against
+	 */
+	const UClass* GetCompiledClass() const
+	{
+		return CompiledClass.Get();
+	}
+
+	/**
+	 * Is handle compiled against specified class and still up to date
+	 */
+	bool IsCompiledFor(const UClass* InClass) const
+	{
+		return InClass != nullptr
+			&& InClass == CompiledClass.Get()
+			&& Generation == FBlueprintComponentReferenceCache::GetGeneration();
+	}
+
+	/**
+	 * Get the actual component pointer from this reference
+	 *
+	 * @param SearchActor Actor to perform search in
+	 * @return Found component or null if search failed
+	 */
+	UActorComponent* GetComponent(const AActor* SearchActor) const;
+
+	/**
+	 * Get the actual component pointer from this reference
+	 *
+	 * @param SearchActor Actor to perform search in
+	 * @return Found component or null if search failed
+	 */
+	template<typename T>
+	T* GetComponent(const AActor* SearchActor) const
+	{
+		return Cast<T>(GetComponent(SearchActor));
+	}
+
+private:
+	// source reference
+	FBlueprintComponentReference Reference;
+	// property access plan, valid only in Property mode
+	FComponentReferencePlan Plan;
+	// class handle was compiled against
+	TWeakObjectPtr<const UClass> CompiledClass;
+	// plan cache generation at compile time
+	uint32 Generation = 0;
+};
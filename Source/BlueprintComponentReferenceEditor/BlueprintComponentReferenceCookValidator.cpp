@@ -0,0 +1,141 @@
+// Copyright 2024, Aquanox.
+
+#include "BlueprintComponentReferenceCookValidator.h"
+#include "BlueprintComponentReference.h"
+#include "BlueprintComponentReferenceCache.h"
+#include "BlueprintComponentReferenceEditor.h"
+#include "BlueprintComponentReferenceMetadata.h"
+#include "ComponentReferenceSchema.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+#include "UObject/ObjectSaveContext.h"
+#endif
+
+namespace BCRCook
+{
+	static TAutoConsoleVariable<bool> CVarValidateOnCook(
+		TEXT("BCR.ValidateOnCook"),
+		true,
+		TEXT("Report component references that can not be resolved in cooked objects"));
+
+	/**
+	 * Find actor that owns the object. Component templates of construction script are outered to
+	 * generated class rather than to default object, in that case class is returned instead.
+	 */
+	static const UClass* FindOwnerActorClass(const UObject* InObject, const AActor*& OutActor)
+	{
+		OutActor = nullptr;
+		for (const UObject* Outer = InObject; Outer; Outer = Outer->GetOuter())
+		{
+			if (const AActor* Actor = Cast<AActor>(Outer))
+			{
+				OutActor = Actor;
+				return Actor->GetClass();
+			}
+			if (const UClass* Class = Cast<UClass>(Outer))
+			{
+				return Class->IsChildOf(AActor::StaticClass()) ? Class : nullptr;
+			}
+		}
+		return nullptr;
+	}
+}
+
+void FBlueprintComponentReferenceCookValidator::Register()
+{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	PreSaveHandle = FCoreUObjectDelegates::OnObjectSaved.AddRaw(this, &FBlueprintComponentReferenceCookValidator::OnObjectSaved);
+#else
+	PreSaveHandle = FCoreUObjectDelegates::OnObjectPreSave.AddRaw(this, &FBlueprintComponentReferenceCookValidator::OnObjectPreSave);
+#endif
+}
+
+void FBlueprintComponentReferenceCookValidator::Unregister()
+{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FCoreUObjectDelegates::OnObjectSaved.Remove(PreSaveHandle);
+#else
+	FCoreUObjectDelegates::OnObjectPreSave.Remove(PreSaveHandle);
+#endif
+	PreSaveHandle.Reset();
+}
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+void FBlueprintComponentReferenceCookValidator::OnObjectSaved(UObject* InObject)
+{
+	// no save context available, any commandlet save is treated as cook
+	if (IsRunningCommandlet() && BCRCook::CVarValidateOnCook.GetValueOnGameThread())
+	{
+		ValidateObject(InObject);
+	}
+}
+#else
+void FBlueprintComponentReferenceCookValidator::OnObjectPreSave(UObject* InObject, FObjectPreSaveContext InContext)
+{
+	if (InContext.IsCooking() && BCRCook::CVarValidateOnCook.GetValueOnGameThread())
+	{
+		ValidateObject(InObject);
+	}
+}
+#endif
+
+int32 FBlueprintComponentReferenceCookValidator::ValidateObject(const UObject* InObject)
+{
+	if (!InObject)
+	{
+		return 0;
+	}
+
+	const AActor* OwnerActor = nullptr;
+	const UClass* OwnerClass = BCRCook::FindOwnerActorClass(InObject, OwnerActor);
+	// level actors are checked against instance, so instance added components are not reported
+	const bool bIsInstance = OwnerActor && !OwnerActor->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject);
+
+	int32 NumFailed = 0;
+
+	FComponentReferenceSchema::Get(InObject->GetClass())->ForEachReferenceField(InObject, [&](const FProperty* InField, const FBlueprintComponentReference& InReference)
+	{
+		if (InReference.IsNull())
+		{
+			return;
+		}
+
+		const UClass* ActorClass = nullptr;
+		FMetadataMarshaller::GetClassMetadata(InField, FCRMetadataKey::ActorClass, [&ActorClass](UClass* InClass)
+		{
+			ActorClass = InClass;
+		});
+
+		bool bResolved;
+		if (ActorClass)
+		{
+			bResolved = FBlueprintComponentReferenceCache::CanResolveInClass(InReference, ActorClass);
+		}
+		else if (bIsInstance)
+		{
+			bResolved = InReference.GetComponent(OwnerActor) != nullptr || FBlueprintComponentReferenceCache::CanResolveInClass(InReference, OwnerClass);
+		}
+		else if (OwnerClass)
+		{
+			ActorClass = OwnerClass;
+			bResolved = FBlueprintComponentReferenceCache::CanResolveInClass(InReference, ActorClass);
+		}
+		else
+		{ // nothing to check against
+			return;
+		}
+
+		if (!bResolved)
+		{
+			++NumFailed;
+			UE_LOG(LogComponentReferenceEditor, Warning, TEXT("Component reference '%s' in %s of %s can not be resolved in %s"),
+				*InReference.ToString(), *InField->GetName(), *InObject->GetPathName(), *GetNameSafe(ActorClass ? ActorClass : OwnerClass));
+		}
+	});
+
+	return NumFailed;
+}
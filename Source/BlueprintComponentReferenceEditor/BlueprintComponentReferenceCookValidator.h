@@ -0,0 +1,44 @@
+// Copyright 2024, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+class FObjectPreSaveContext;
+#endif
+
+/**
+ * Validates component references of objects that are being cooked.
+ *
+ * Each reference found in object properties, containers and nested structs is checked against
+ * the actor class it will be resolved in: owning actor for actors and their components,
+ * ActorClass metadata for everything else, with FBlueprintComponentReferenceCache::CanResolveInClass.
+ * References that can not be resolved are reported as cook warnings, references without a determinable actor class are skipped.
+ *
+ * Controlled by BCR.ValidateOnCook console variable.
+ */
+class BLUEPRINTCOMPONENTREFERENCEEDITOR_API FBlueprintComponentReferenceCookValidator
+{
+public:
+	void Register();
+	void Unregister();
+
+	/**
+	 * Validate references of single object
+	 *
+	 * @param InObject Object to check
+	 * @return Number of references that failed to resolve
+	 */
+	static int32 ValidateObject(const UObject* InObject);
+
+private:
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	void OnObjectSaved(UObject* InObject);
+#else
+	void OnObjectPreSave(UObject* InObject, FObjectPreSaveContext InContext);
+#endif
+
+	FDelegateHandle PreSaveHandle;
+};
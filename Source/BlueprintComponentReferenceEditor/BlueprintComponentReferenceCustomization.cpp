@@ -433,8 +433,12 @@ void FBlueprintComponentReferenceCustomization::SetValue(const FBlueprintCompone
 	const bool bIsEmpty = Value.IsNull();
 	if (bIsEmpty || IsComponentReferenceValid(Value))
 	{
+		// compact form is read back by native text import without going through tagged property parsing
 		FString TextValue;
-		CastFieldChecked<const FStructProperty>(PropertyHandle->GetProperty())->Struct->ExportText(TextValue, &Value, &Value, nullptr, EPropertyPortFlags::PPF_None, nullptr);
+		if (!Value.ExportTextItem(TextValue, Value, nullptr, EPropertyPortFlags::PPF_None, nullptr))
+		{
+			CastFieldChecked<const FStructProperty>(PropertyHandle->GetProperty())->Struct->ExportText(TextValue, &Value, &Value, nullptr, EPropertyPortFlags::PPF_None, nullptr);
+		}
 		ensure(PropertyHandle->SetValueFromFormattedString(TextValue) == FPropertyAccess::Result::Success);
 	}
 }
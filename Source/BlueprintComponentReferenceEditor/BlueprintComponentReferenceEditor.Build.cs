@@ -39,6 +39,7 @@ public class BlueprintComponentReferenceEditor : ModuleRules
 			"ApplicationCore",
 			"Kismet",
 			"BlueprintGraph",
+			"KismetCompiler",
 			"EditorStyle"
 		});
 	}
@@ -1,6 +1,7 @@
 // Copyright 2024, Aquanox.
 
 #include "BlueprintComponentReferenceEditor.h"
+#include "BlueprintComponentReferenceCache.h"
 #include "BlueprintComponentReferenceCustomization.h"
 #include "BlueprintComponentReferenceVarCustomization.h"
 #include "BlueprintEditorModule.h"
@@ -56,6 +57,9 @@ static FAutoConsoleCommand BCR_EnableLogging(
 
 void FBCREditorModule::StartupModule()
 {
+	// cook runs as commandlet, validation is registered regardless of editor mode
+	CookValidator.Register();
+
 	if (GIsEditor && !IsRunningCommandlet())
 	{
 		ClassHelper = MakeShared<FBlueprintComponentReferenceHelper>();
@@ -94,6 +98,8 @@ void FBCREditorModule::OnPostEngineInit()
 
 void FBCREditorModule::ShutdownModule()
 {
+	CookValidator.Unregister();
+
 	if (GIsEditor && !IsRunningCommandlet())
 	{
 		FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
@@ -170,6 +176,9 @@ void FBCREditorModule::OnModulesChanged(FName Name, EModuleChangeReason ModuleCh
 void FBCREditorModule::OnBlueprintRecompile()
 {
 	UE_LOG(LogComponentReferenceEditor, Verbose, TEXT("OnBlueprintRecompile"));
+
+	FBlueprintComponentReferenceCache::Reset();
+
 	if (ClassHelper)
 	{
 		ClassHelper->CleanupStaleData();
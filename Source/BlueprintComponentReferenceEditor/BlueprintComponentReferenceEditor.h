@@ -4,6 +4,7 @@
 
 #include "Modules/ModuleInterface.h"
 #include "Modules/ModuleManager.h"
+#include "BlueprintComponentReferenceCookValidator.h"
 
 class FBlueprintComponentReferenceHelper;
 enum class EReloadCompleteReason;
@@ -25,6 +26,8 @@ private:
 private:
 	TSharedPtr<FBlueprintComponentReferenceHelper> ClassHelper;
 
+	FBlueprintComponentReferenceCookValidator CookValidator;
+
 	FDelegateHandle VariableCustomizationHandle;
 	FDelegateHandle PostEngineInitHandle;
 
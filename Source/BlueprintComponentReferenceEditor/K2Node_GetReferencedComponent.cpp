@@ -0,0 +1,140 @@
+// Copyright 2024, Aquanox.
+
+#include "K2Node_GetReferencedComponent.h"
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintComponentReference.h"
+#include "BlueprintComponentReferenceLibrary.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "GameFramework/Actor.h"
+#include "K2Node_DynamicCast.h"
+#include "K2Node_VariableGet.h"
+#include "KismetCompiler.h"
+
+namespace K2Node_GetReferencedComponent
+{
+	static const FName ReferencePinName(TEXT("Reference"));
+	static const FName ActorPinName(TEXT("Actor"));
+	static const FName ClassPinName(TEXT("Class"));
+	static const FName ComponentPinName(TEXT("Component"));
+}
+
+UK2Node_GetReferencedComponent::UK2Node_GetReferencedComponent()
+{
+	FunctionReference.SetExternalMember(
+		GET_FUNCTION_NAME_CHECKED(UBlueprintComponentReferenceLibrary, GetReferencedComponent),
+		UBlueprintComponentReferenceLibrary::StaticClass()
+	);
+}
+
+const FObjectProperty* UK2Node_GetReferencedComponent::FindLiteralProperty(const UClass* SelfClass) const
+{
+	using namespace K2Node_GetReferencedComponent;
+
+	if (!SelfClass || !SelfClass->IsChildOf(AActor::StaticClass()))
+	{
+		return nullptr;
+	}
+
+	// actor must be self
+	const UEdGraphPin* ActorPin = FindPin(ActorPinName);
+	if (!ActorPin || ActorPin->LinkedTo.Num() != 0 || ActorPin->DefaultObject != nullptr)
+	{
+		return nullptr;
+	}
+
+	// reference must be a literal
+	const UEdGraphPin* ReferencePin = FindPin(ReferencePinName);
+	if (!ReferencePin || ReferencePin->LinkedTo.Num() != 0 || ReferencePin->DefaultValue.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	// expected class must be known at compile time
+	const UEdGraphPin* ClassPin = FindPin(ClassPinName);
+	if (ClassPin && ClassPin->LinkedTo.Num() != 0)
+	{
+		return nullptr;
+	}
+
+	FBlueprintComponentReference Reference;
+	UScriptStruct* const ReferenceStruct = StaticStruct<FBlueprintComponentReference>();
+	if (!ReferenceStruct->ImportText(*ReferencePin->DefaultValue, &Reference, nullptr, PPF_None, nullptr, ReferenceStruct->GetName()))
+	{
+		return nullptr;
+	}
+
+	if (Reference.GetMode() != EBlueprintComponentReferenceMode::Property)
+	{
+		return nullptr;
+	}
+
+	// weak and soft properties need a resolve, non-visible ones can not be accessed with variable get
+	const FObjectProperty* Property = FindFProperty<FObjectProperty>(SelfClass, Reference.GetValue());
+	if (!Property
+		|| !Property->HasAnyPropertyFlags(CPF_BlueprintVisible)
+		|| !Property->PropertyClass
+		|| !Property->PropertyClass->IsChildOf(UActorComponent::StaticClass()))
+	{
+		return nullptr;
+	}
+
+	return Property;
+}
+
+void UK2Node_GetReferencedComponent::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	using namespace K2Node_GetReferencedComponent;
+
+	const UClass* SelfClass = CompilerContext.Blueprint ? CompilerContext.Blueprint->SkeletonGeneratedClass : nullptr;
+	const FObjectProperty* Property = FindLiteralProperty(SelfClass);
+	if (!Property)
+	{
+		// resolve through library call, property plans are cached at runtime
+		Super::ExpandNode(CompilerContext, SourceGraph);
+		return;
+	}
+
+	UEdGraphPin* ClassPin = FindPin(ClassPinName);
+	UClass* TargetClass = ClassPin ? Cast<UClass>(ClassPin->DefaultObject) : nullptr;
+	if (!TargetClass)
+	{
+		TargetClass = UActorComponent::StaticClass();
+	}
+
+	UK2Node_VariableGet* GetNode = CompilerContext.SpawnIntermediateNode<UK2Node_VariableGet>(this, SourceGraph);
+	GetNode->VariableReference.SetSelfMember(Property->GetFName());
+	GetNode->AllocateDefaultPins();
+
+	UK2Node_DynamicCast* CastNode = CompilerContext.SpawnIntermediateNode<UK2Node_DynamicCast>(this, SourceGraph);
+	CastNode->TargetType = TargetClass;
+	CastNode->SetPurity(true);
+	CastNode->AllocateDefaultPins();
+
+	const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+	UEdGraphPin* ValuePin = GetNode->FindPin(Property->GetFName(), EGPD_Output);
+	if (!ValuePin || !Schema->TryCreateConnection(ValuePin, CastNode->GetCastSourcePin()))
+	{
+		CompilerContext.MessageLog.Error(*NSLOCTEXT("BlueprintComponentReference", "LiteralExpandFailed", "Failed to compile component reference for @@").ToString(), this);
+		BreakAllNodeLinks();
+		return;
+	}
+
+	CompilerContext.MovePinLinksToIntermediate(*FindPinChecked(ComponentPinName), *CastNode->GetCastResultPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetReturnValuePin(), *CastNode->GetBoolSuccessPin());
+
+	BreakAllNodeLinks();
+}
+
+void UK2Node_GetReferencedComponent::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* const ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
@@ -0,0 +1,31 @@
+// Copyright 2024, Aquanox.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_GetReferencedComponent.generated.h"
+
+/**
+ * Blueprint node for resolving component reference in actor.
+ *
+ * When reference is a literal property reference, actor is self and property is visible on self class
+ * the node compiles into a variable get followed by a pure cast, skipping resolve at runtime entirely.
+ * Otherwise it is compiled as a regular call.
+ *
+ * @see UBlueprintComponentReferenceLibrary::GetReferencedComponent
+ */
+UCLASS(MinimalAPI)
+class UK2Node_GetReferencedComponent : public UK2Node_CallFunction
+{
+	GENERATED_BODY()
+public:
+	UK2Node_GetReferencedComponent();
+
+	virtual void ExpandNode(class FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+
+private:
+	/** Find component property that literal reference can be compiled to, null if node needs a call */
+	const FObjectProperty* FindLiteralProperty(const UClass* SelfClass) const;
+};
@@ -175,7 +175,7 @@ class ABCRTestActorWithChild : public ABCRTestActor
 	GENERATED_BODY()
 public:
 	ABCRTestActorWithChild();
-	// unsupported, can reference only component, not instanced things within spawned actor
+	// components within spawned actor are referenced with Nested mode, "LevelNope.CollisionComponent"
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Components)
 	UChildActorComponent* LevelNope = nullptr;
 
@@ -203,6 +203,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Test|Cached", meta=(AllowedClasses="/Script/Engine.SceneComponent"))
 	TMap<FBlueprintComponentReference, FBCRTestStrustData> ReferenceMapKey;
 
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Test|Cached", meta=(AllowedClasses="/Script/Engine.SceneComponent"))
+	TSet<FBlueprintComponentReference> ReferenceSet;
+
 #if WITH_CACHED_COMPONENT_REFERENCE_TESTS
 
 	TCachedComponentReferenceSingle<USceneComponent> CachedReferenceSingle { this, &ReferenceSingle };
@@ -213,6 +216,8 @@ public:
 
 	TCachedComponentReferenceMapKey<USceneComponent, FBCRTestStrustData> CachedReferenceMapKey { this, &ReferenceMapKey };
 
+	TCachedComponentReferenceSet<USceneComponent> CachedReferenceSet { this, &ReferenceSet };
+
 #endif
 
 };
@@ -11,11 +11,35 @@
 #include "Misc/AutomationTest.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "CachedBlueprintComponentReference.h"
+#include "BlueprintComponentReferenceArray.h"
+#include "ComponentReferenceSchema.h"
+#include "ComponentReferenceLiteral.h"
+#include "BlueprintComponentReferenceSubsystem.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/CoreNet.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectReader.h"
+#include "Serialization/ObjectWriter.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include <atomic>
 
 #if WITH_CACHED_COMPONENT_REFERENCE_TESTS && WITH_DEV_AUTOMATION_TESTS
 
+struct FBlueprintComponentReferenceLibraryTestAccess
+{
+	static bool Map_FindComponent(const void* TargetMap, const FMapProperty* MapProperty, const void* KeyPtr, void* OutValuePtr)
+	{
+		return UBlueprintComponentReferenceLibrary::Map_FindComponent_Impl(TargetMap, MapProperty, KeyPtr, OutValuePtr);
+	}
+};
+
 void EnsureTemplatesCompile(ABCRCachedTestActor* Target)
 {
 	check(!"This is just to ensure template code compiles during autobuild");
@@ -40,6 +64,41 @@ void EnsureTemplatesCompile(ABCRCachedTestActor* Target)
 	Target->CachedReferenceMap.Get(PtrToActor, NAME_None);
 	Target->CachedReferenceMapKey.Get(PtrToComponent);
 	Target->CachedReferenceMapKey.Get(PtrToActor, PtrToComponent);
+	Target->CachedReferenceMapKey.MarkSourceChanged();
+	Target->CachedReferenceSet.Contains(PtrToComponent);
+	Target->CachedReferenceSet.Contains(PtrToActor, PtrToComponent);
+	Target->CachedReferenceSet.Num();
+	Target->CachedReferenceSet.IsEmpty();
+	Target->CachedReferenceSet.MarkSourceChanged();
+	Target->CachedReferenceSet.Invalidate();
+
+	UBlueprintComponentReferenceSubsystem* Subsystem = nullptr;
+	Subsystem->QueueResolve(Target, Target->CachedReferenceSingle);
+	Subsystem->QueueResolve(Target, Target->CachedReferenceArray);
+	Subsystem->QueueResolve(Target, Target->CachedReferenceMap);
+	Subsystem->QueueResolve(Target, Target->CachedReferenceMapKey);
+	Subsystem->QueueResolve(Target, Target->CachedReferenceSet, EComponentReferenceResolvePriority::High);
+
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	FReferenceCollector* Collector = nullptr;
+	TCachedComponentReferenceSingle<USceneComponent, BCRDetails::TObjectPtrFuncs> ObjectPtrSingle { Target, &Target->ReferenceSingle };
+	TCachedComponentReferenceArray<USceneComponent, BCRDetails::TObjectPtrFuncs> ObjectPtrArray { Target, &Target->ReferenceArray };
+	ObjectPtrSingle.Get();
+	ObjectPtrSingle.AddReferencedObjects(*Collector, Target);
+	ObjectPtrArray.Get(0);
+	ObjectPtrArray.AddReferencedObjects(*Collector, Target);
+#endif
+
+	TConcurrentCachedComponentReference<USceneComponent> Concurrent { Target, &Target->ReferenceSingle };
+	Concurrent.Get();
+	Concurrent.GetPublished();
+	Concurrent.Resolve();
+	Concurrent.Invalidate();
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	TConcurrentCachedComponentReference<USceneComponent, BCRDetails::TObjectPtrFuncs> ObjectPtrConcurrent { Target, &Target->ReferenceSingle };
+	ObjectPtrConcurrent.Get();
+	ObjectPtrConcurrent.AddReferencedObjects(*Collector, Target);
+#endif
 }
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintComponentReferenceTests_Cached,
@@ -55,6 +114,7 @@ bool FBlueprintComponentReferenceTests_Cached::RunTest(FString const&)
 	TestActor->ReferenceArray.Empty();
 	TestActor->ReferenceMap.Empty();
 	TestActor->ReferenceMapKey.Empty();
+	TestActor->ReferenceSet.Empty();
 
 	//======================================
 
@@ -68,6 +128,96 @@ bool FBlueprintComponentReferenceTests_Cached::RunTest(FString const&)
 	TestTrueExpr(TestActor->CachedReferenceSingle.Get() == ExpectedComp);
 	TestTrueExpr(TestActor->CachedReferenceSingle.Get(TestActor) == ExpectedComp);
 
+	// source change is picked up without explicit invalidation, copies keep revision of their source
+	{
+		FBlueprintComponentReference Copy = TestActor->ReferenceSingle;
+		TestTrueExpr(Copy.GetRevision() == TestActor->ReferenceSingle.GetRevision());
+		Copy = FBlueprintComponentReference::ForPath(ABCRCachedTestActor::MeshComponentName);
+		TestTrueExpr(Copy == TestActor->ReferenceSingle);
+		TestTrueExpr(Copy.GetRevision() != TestActor->ReferenceSingle.GetRevision());
+		TestTrueExpr(FBlueprintComponentReference().GetRevision() == 0);
+	}
+	TestActor->ReferenceSingle = FBlueprintComponentReference::ForProperty(TEXT("RootComponent"));
+	TestTrueExpr(TestActor->CachedReferenceSingle.Get() == TestActor->GetRootComponent());
+	TestActor->ReferenceSingle = FBlueprintComponentReference::ForPath(ABCRCachedTestActor::MeshComponentName);
+	TestTrueExpr(TestActor->CachedReferenceSingle.Get() == ExpectedComp);
+
+	// dynamic selection is refreshed when tags are reported changed
+	TestActor->ReferenceSingle = FBlueprintComponentReference::ForClass(USkeletalMeshComponent::StaticClass());
+	TestTrueExpr(TestActor->CachedReferenceSingle.Get() == ExpectedComp);
+	TestActor->ReferenceSingle = FBlueprintComponentReference::ForTag(TEXT("Weakpoint"));
+	TestTrueExpr(TestActor->CachedReferenceSingle.Get() == nullptr);
+	TestActor->GetCapsuleComponent()->ComponentTags.Add(TEXT("Weakpoint"));
+	FBlueprintComponentReferenceCache::InvalidateActor(TestActor);
+	TestTrueExpr(TestActor->CachedReferenceSingle.Get() == TestActor->GetCapsuleComponent());
+	TestActor->GetCapsuleComponent()->ComponentTags.Remove(TEXT("Weakpoint"));
+	FBlueprintComponentReferenceCache::InvalidateActor(TestActor);
+	TestTrueExpr(TestActor->CachedReferenceSingle.Get() == nullptr);
+	TestActor->ReferenceSingle = FBlueprintComponentReference::ForPath(ABCRCachedTestActor::MeshComponentName);
+
+	// component generation is kept per actor and shared with helpers through slot
+	{
+		auto* OtherActor = World->SpawnActor<ABCRCachedTestActor>();
+
+		// reads do not create state
+		auto* PlainActor = World->SpawnActor<AActor>();
+		TestTrueExpr(FBlueprintComponentReferenceCache::GetActorGeneration(PlainActor) == 0);
+		PlainActor->Destroy();
+
+		const FActorGenerationRef ActorSlot = FBlueprintComponentReferenceCache::AcquireActorGeneration(TestActor);
+		const FActorGenerationRef OtherSlot = FBlueprintComponentReferenceCache::AcquireActorGeneration(OtherActor);
+		const uint32 ActorGeneration = ActorSlot->Load();
+		const uint32 OtherGeneration = OtherSlot->Load();
+		TestTrueExpr(ActorGeneration != 0 && OtherGeneration != 0 && ActorGeneration != OtherGeneration);
+		TestTrueExpr(FBlueprintComponentReferenceCache::GetActorGeneration(TestActor) == ActorGeneration);
+
+		FBlueprintComponentReferenceCache::InvalidateActor(TestActor);
+		TestTrueExpr(ActorSlot->Load() != 0 && ActorSlot->Load() != ActorGeneration);
+		TestTrueExpr(FBlueprintComponentReferenceCache::GetActorGeneration(TestActor) == ActorSlot->Load());
+		TestTrueExpr(OtherSlot->Load() == OtherGeneration);
+		TestTrueExpr(TestActor->CachedReferenceSingle.Get() == ExpectedComp);
+		TestTrueExpr(TestActor->CachedReferenceSingle.GetStorage().ActorGeneration == ActorSlot);
+
+		// remove and add keeps number of components, created component is still noticed
+		auto* Replaced = NewObject<UBCRTestSceneComponent>(OtherActor);
+		Replaced->RegisterComponent();
+		const uint32 BeforeReplace = FBlueprintComponentReferenceCache::AcquireActorGeneration(OtherActor)->Load();
+		Replaced->DestroyComponent();
+		auto* Replacement = NewObject<UBCRTestSceneComponent>(OtherActor);
+		Replacement->RegisterComponent();
+		TestTrueExpr(OtherSlot->Load() != BeforeReplace);
+		TestTrueExpr(FBlueprintComponentReferenceCache::AcquireActorGeneration(OtherActor)->Load() != BeforeReplace);
+
+		// destroyed actor state is dropped, slot never matches again
+		FBlueprintComponentReferenceCache::ForgetActor(OtherActor);
+		TestTrueExpr(OtherSlot->Load() == 0);
+
+		OtherActor->Destroy();
+	}
+
+	// deferred resolve fills cache before it is accessed
+	if (UBlueprintComponentReferenceSubsystem* Subsystem = World->GetSubsystem<UBlueprintComponentReferenceSubsystem>())
+	{
+		Subsystem->Flush();
+		TestActor->CachedReferenceSingle.Invalidate();
+		Subsystem->QueueResolve(TestActor, TestActor->CachedReferenceSingle);
+		Subsystem->QueueResolve(TestActor, TestActor->CachedReferenceMap, EComponentReferenceResolvePriority::High);
+		TestTrueExpr(Subsystem->GetNumPending() == 2);
+		TestTrueExpr(Subsystem->Flush() == 2);
+		TestTrueExpr(Subsystem->GetNumPending() == 0);
+		TestTrueExpr(TestActor->CachedReferenceSingle.GetStorage().Component.Get() == ExpectedComp);
+
+		// registered helpers are filled again with each warmup of actor
+		Subsystem->RegisterCached(TestActor, TestActor->CachedReferenceSingle);
+		TestTrueExpr(Subsystem->GetNumPending() == 1);
+		Subsystem->Flush();
+		Subsystem->NotifyActorReused(TestActor);
+		TestTrueExpr(!TestActor->CachedReferenceSingle.GetStorage().IsValidFor(TestActor, TestActor->ReferenceSingle));
+		TestTrueExpr(Subsystem->Flush() == 1);
+		TestTrueExpr(TestActor->CachedReferenceSingle.GetStorage().IsValidFor(TestActor, TestActor->ReferenceSingle));
+		TestTrueExpr(TestActor->CachedReferenceSingle.GetStorage().Component.Get() == ExpectedComp);
+	}
+
 	//======================================
 
 	TArray<UBCRTestSceneComponent*> ExpectedComps;
@@ -92,6 +242,12 @@ bool FBlueprintComponentReferenceTests_Cached::RunTest(FString const&)
 		FBCRTestStrustData Data;
 		Data.Sample = Comp->SampleName;
 		TestActor->ReferenceMapKey.Add(FBlueprintComponentReference::ForPath(Comp->GetFName()), Data);
+
+		// last component is left out of the set
+		if (i < 3)
+		{
+			TestActor->ReferenceSet.Add(FBlueprintComponentReference::ForPath(Comp->GetFName()));
+		}
 	}
 
 	TestTrueExpr(ExpectedComps.Num() == TestActor->ReferenceArray.Num() );
@@ -148,9 +304,293 @@ bool FBlueprintComponentReferenceTests_Cached::RunTest(FString const&)
 		TestTrueExpr(InKey->SampleName == CachedBased->Sample);
 	}
 
+	// key replaced at same count through helper is picked up
+	{
+		auto& CachedMapKey = TestActor->CachedReferenceMapKey;
+		const FBlueprintComponentReference OldKey = FBlueprintComponentReference::ForPath(ExpectedComps[0]->GetFName());
+		const FBlueprintComponentReference MeshKey = FBlueprintComponentReference::ForProperty(ABCRCachedTestActor::MeshPropertyName);
+		const int32 NumKeys = TestActor->ReferenceMapKey.Num();
+
+		FBCRTestStrustData Data = TestActor->ReferenceMapKey.FindChecked(OldKey);
+		CachedMapKey.Remove(OldKey);
+		CachedMapKey.Add(MeshKey, Data);
+		TestTrueExpr(TestActor->ReferenceMapKey.Num() == NumKeys);
+		TestTrueExpr(!CachedMapKey.GetStorage().IsValidFor(TestActor, NumKeys));
+		TestTrueExpr(CachedMapKey.Get(ExpectedComps[0]) == nullptr);
+		TestTrueExpr(CachedMapKey.Get(TestActor, TestActor->GetMesh()) == TestActor->ReferenceMapKey.Find(MeshKey));
+
+		// direct replace is not dangling even before it is reported
+		TestActor->ReferenceMapKey.Remove(MeshKey);
+		TestActor->ReferenceMapKey.Add(OldKey, Data);
+		TestTrueExpr(CachedMapKey.GetStorage().IsValidFor(TestActor, NumKeys));
+		TestTrueExpr(CachedMapKey.Get(TestActor, TestActor->GetMesh()) == nullptr);
+		CachedMapKey.MarkSourceChanged();
+		TestTrueExpr(!CachedMapKey.GetStorage().IsValidFor(TestActor, NumKeys));
+		FBCRTestStrustData* Restored = CachedMapKey.Get(ExpectedComps[0]);
+		TestTrueExpr(Restored == TestActor->ReferenceMapKey.Find(OldKey));
+		TestTrueExpr(Restored && Restored->Sample == ExpectedComps[0]->SampleName);
+	}
+
+	//======================================
+
+	const FMapProperty* MapKeyProperty = FindFProperty<FMapProperty>(ABCRCachedTestActor::StaticClass(), GET_MEMBER_NAME_CHECKED(ABCRCachedTestActor, ReferenceMapKey));
+	TestTrueExpr(MapKeyProperty != nullptr);
+
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{ // second pass goes through lookup built by first one
+		for (UBCRTestSceneComponent* InKey : ExpectedComps)
+		{
+			FBCRTestStrustData Found;
+			TestTrueExpr(FBlueprintComponentReferenceLibraryTestAccess::Map_FindComponent(&TestActor->ReferenceMapKey, MapKeyProperty, InKey, &Found));
+			TestTrueExpr(InKey->SampleName == Found.Sample);
+		}
+	}
+
+	{
+		FBCRTestStrustData Found;
+		TestTrueExpr(!FBlueprintComponentReferenceLibraryTestAccess::Map_FindComponent(&TestActor->ReferenceMapKey, MapKeyProperty, TestActor->GetMesh(), &Found));
+
+		// replaced key is picked up without changing map size once search hits replaced element,
+		// misses within same frame are answered from lookup without comparing elements
+		const FBlueprintComponentReference OldKey = FBlueprintComponentReference::ForPath(ExpectedComps[0]->GetFName());
+		FBCRTestStrustData Data = TestActor->ReferenceMapKey.FindAndRemoveChecked(OldKey);
+		TestActor->ReferenceMapKey.Add(FBlueprintComponentReference::ForProperty(ABCRCachedTestActor::MeshPropertyName), Data);
+		TestTrueExpr(!FBlueprintComponentReferenceLibraryTestAccess::Map_FindComponent(&TestActor->ReferenceMapKey, MapKeyProperty, ExpectedComps[0], &Found));
+		TestTrueExpr(FBlueprintComponentReferenceLibraryTestAccess::Map_FindComponent(&TestActor->ReferenceMapKey, MapKeyProperty, TestActor->GetMesh(), &Found));
+	}
+
+	//======================================
+
+	TestTrueExpr(TestActor == TestActor->CachedReferenceSet.GetBaseActor() );
+	TestTrueExpr(TestActor->CachedReferenceSet.Num() == 3);
+	TestTrueExpr(TestActor->CachedReferenceSet.Contains(ExpectedComps[0]));
+	TestTrueExpr(TestActor->CachedReferenceSet.Contains(TestActor, ExpectedComps[2]));
+	TestTrueExpr(!TestActor->CachedReferenceSet.Contains(ExpectedComps[3]));
+	TestTrueExpr(!TestActor->CachedReferenceSet.Contains(TestActor->GetMesh()));
+	TestTrueExpr(!TestActor->CachedReferenceSet.Contains(nullptr));
+
+	// growing source set is picked up without explicit invalidation
+	TestActor->ReferenceSet.Add(FBlueprintComponentReference::ForPath(ExpectedComps[3]->GetFName()));
+	TestTrueExpr(TestActor->CachedReferenceSet.Contains(ExpectedComps[3]));
+
+	// element replaced through helper keeps set size and is picked up as well
+	TestActor->CachedReferenceSet.Remove(FBlueprintComponentReference::ForPath(ExpectedComps[0]->GetFName()));
+	TestActor->CachedReferenceSet.Add(FBlueprintComponentReference::ForProperty(ABCRCachedTestActor::MeshPropertyName));
+	TestTrueExpr(!TestActor->CachedReferenceSet.GetStorage().IsValidFor(TestActor, TestActor->ReferenceSet));
+	TestTrueExpr(TestActor->CachedReferenceSet.Num() == 4);
+	TestTrueExpr(!TestActor->CachedReferenceSet.Contains(ExpectedComps[0]));
+	TestTrueExpr(TestActor->CachedReferenceSet.Contains(TestActor->GetMesh()));
+	TestTrueExpr(TestActor->CachedReferenceSet.GetStorage().IsValidFor(TestActor, TestActor->ReferenceSet));
+
+	// direct replace is not detected until reported, queries in between do not rescan the set
+	TestActor->ReferenceSet.Remove(FBlueprintComponentReference::ForProperty(ABCRCachedTestActor::MeshPropertyName));
+	TestActor->ReferenceSet.Add(FBlueprintComponentReference::ForPath(ExpectedComps[0]->GetFName()));
+	TestTrueExpr(TestActor->CachedReferenceSet.GetStorage().IsValidFor(TestActor, TestActor->ReferenceSet));
+	TestActor->CachedReferenceSet.MarkSourceChanged();
+	TestTrueExpr(!TestActor->CachedReferenceSet.GetStorage().IsValidFor(TestActor, TestActor->ReferenceSet));
+	TestTrueExpr(TestActor->CachedReferenceSet.Contains(ExpectedComps[0]));
+	TestTrueExpr(!TestActor->CachedReferenceSet.Contains(TestActor->GetMesh()));
+
+	//======================================
+
+	FBlueprintComponentReferenceArray FastArray;
+	FastArray.SetOwner(TestActor);
+	for (UBCRTestSceneComponent* Comp : ExpectedComps)
+	{
+		FastArray.Add(FBlueprintComponentReference::ForPath(Comp->GetFName()));
+	}
+
+	TestTrueExpr(FastArray.Num() == ExpectedComps.Num());
+	TestTrueExpr(FastArray.GetComponent(0) == ExpectedComps[0]);
+	TestTrueExpr(FastArray.GetComponent<USceneComponent>(3) == ExpectedComps[3]);
+	TestTrueExpr(FastArray.GetComponent(4) == nullptr);
+	TestTrueExpr(FastArray.IndexOfComponent(ExpectedComps[2]) == 2);
+
+	FastArray.Set(0, FBlueprintComponentReference::ForProperty(ABCRCachedTestActor::MeshPropertyName));
+	TestTrueExpr(FastArray.GetComponent(0) == TestActor->GetMesh());
+	FastArray.RemoveAt(1);
+	TestTrueExpr(FastArray.GetComponent(1) == ExpectedComps[2]);
+	TestTrueExpr(FastArray.IndexOfComponent(ExpectedComps[1]) == INDEX_NONE);
+	TestTrueExpr(FastArray.IndexOfComponent(TestActor->GetMesh()) == 0);
+	TestTrueExpr(FastArray.IndexOfComponent(ExpectedComps[3]) == 2);
+
+	// first of duplicate entries is reported
+	FastArray.Add(FBlueprintComponentReference::ForProperty(ABCRCachedTestActor::MeshPropertyName));
+	TestTrueExpr(FastArray.GetComponent(3) == TestActor->GetMesh());
+	TestTrueExpr(FastArray.IndexOfComponent(TestActor->GetMesh()) == 0);
+	FastArray.RemoveAt(0);
+	TestTrueExpr(FastArray.IndexOfComponent(TestActor->GetMesh()) == 2);
+
  	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintComponentReferenceTests_Concurrent,
+	"BlueprintComponentReference.Concurrent", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter | EAutomationTestFlags::HighPriority);
+
+bool FBlueprintComponentReferenceTests_Concurrent::RunTest(FString const&)
+{
+	FTestWorldScope World;
+
+	auto* TestActor = World->SpawnActor<ABCRCachedTestActor>();
+	TestTrueExpr(TestActor != nullptr);
+
+	USceneComponent* MeshComp = TestActor->GetMesh();
+	USceneComponent* RootComp = TestActor->GetRootComponent();
+	TestTrueExpr(MeshComp != nullptr && MeshComp != RootComp);
+
+	TestActor->ReferenceSingle = FBlueprintComponentReference::ForPath(ABCRCachedTestActor::MeshComponentName);
+
+	TConcurrentCachedComponentReference<USceneComponent> Cached { TestActor, &TestActor->ReferenceSingle };
+	TestTrueExpr(Cached.GetPublished() == nullptr);
+	TestTrueExpr(Cached.Get() == MeshComp);
+	TestTrueExpr(Cached.GetPublished() == MeshComp);
+
+	// new component generation is resolved and published on game thread
+	FBlueprintComponentReferenceCache::InvalidateActor(TestActor);
+	TestTrueExpr(Cached.Get() == MeshComp);
+	TestTrueExpr(Cached.GetPublished() == MeshComp);
+
+	// source change is picked up on game thread
+	TestActor->ReferenceSingle = FBlueprintComponentReference::ForProperty(TEXT("RootComponent"));
+	TestTrueExpr(Cached.Get() == RootComp);
+	Cached.Invalidate();
+	TestTrueExpr(Cached.GetPublished() == nullptr);
+
+	// destroyed component is not handed out even if it was published
+	{
+		auto* Temporary = NewObject<UBCRTestSceneComponent>(TestActor, TEXT("ConcurrentTemporary"));
+		Temporary->RegisterComponent();
+		TestActor->ReferenceSingle = FBlueprintComponentReference::ForPath(Temporary->GetFName());
+		TestTrueExpr(Cached.Get() == Temporary);
+		TestTrueExpr(Cached.GetPublished() == Temporary);
+		Temporary->DestroyComponent();
+		TestTrueExpr(Cached.GetPublished() == nullptr);
+	}
+
+	// moved cache keeps published value
+	{
+		TestActor->ReferenceSingle = FBlueprintComponentReference::ForPath(ABCRCachedTestActor::MeshComponentName);
+		TConcurrentCachedComponentReference<USceneComponent> Source { TestActor, &TestActor->ReferenceSingle };
+		TestTrueExpr(Source.Get() == MeshComp);
+		TConcurrentCachedComponentReference<USceneComponent> Moved { MoveTemp(Source) };
+		TestTrueExpr(Moved.GetPublished() == MeshComp);
+	}
+
+	//======================================
+	// readers on worker threads while game thread invalidates and resolves
+
+	std::atomic<bool> bStop { false };
+	std::atomic<int32> NumReads { 0 };
+	std::atomic<int32> NumInvalid { 0 };
+
+	const int32 NumWorkers = FMath::Clamp(FPlatformMisc::NumberOfWorkerThreadsToSpawn(), 1, 4);
+
+	TArray<TFuture<void>> Workers;
+	for (int32 Index = 0; Index < NumWorkers; ++Index)
+	{
+		Workers.Add(Async(EAsyncExecution::ThreadPool, [&]()
+		{
+			int32 LocalReads = 0;
+			int32 LocalInvalid = 0;
+			while (!bStop.load(std::memory_order_relaxed))
+			{
+				USceneComponent* Value = Cached.Get();
+				if (Value != nullptr && Value != MeshComp && Value != RootComp)
+				{
+					++LocalInvalid;
+				}
+				++LocalReads;
+			}
+			NumReads += LocalReads;
+			NumInvalid += LocalInvalid;
+		}));
+	}
+
+	for (int32 Iteration = 0; Iteration < 20000; ++Iteration)
+	{
+		const bool bMesh = (Iteration & 1) == 0;
+		TestActor->ReferenceSingle = bMesh
+			? FBlueprintComponentReference::ForPath(ABCRCachedTestActor::MeshComponentName)
+			: FBlueprintComponentReference::ForProperty(TEXT("RootComponent"));
+
+		if (Iteration % 7 == 0)
+		{
+			FBlueprintComponentReferenceCache::InvalidateActor(TestActor);
+		}
+		if (Iteration % 3 == 0)
+		{
+			Cached.Invalidate();
+		}
+
+		if (Cached.Get() != (bMesh ? MeshComp : RootComp))
+		{
+			++NumInvalid;
+		}
+	}
+
+	bStop = true;
+	for (TFuture<void>& Worker : Workers)
+	{
+		Worker.Wait();
+	}
+
+	TestTrueExpr(NumInvalid.load() == 0);
+	TestTrueExpr(NumReads.load() > 0);
+
+	//======================================
+	// plan lookups on worker threads while game thread drops plan cache as on hot reload
+
+	const FObjectPropertyBase* MeshProperty = FindFProperty<FObjectPropertyBase>(ABCRCachedTestActor::StaticClass(), ABCRCachedTestActor::MeshPropertyName);
+	TestTrueExpr(MeshProperty != nullptr);
+
+	bStop = false;
+	NumReads = 0;
+	NumInvalid = 0;
+
+	Workers.Reset();
+	for (int32 Index = 0; Index < NumWorkers; ++Index)
+	{
+		Workers.Add(Async(EAsyncExecution::ThreadPool, [&]()
+		{
+			int32 LocalReads = 0;
+			int32 LocalInvalid = 0;
+			while (!bStop.load(std::memory_order_relaxed))
+			{
+				const FComponentReferencePlan Plan = FBlueprintComponentReferenceCache::FindPlan(ABCRCachedTestActor::StaticClass(), ABCRCachedTestActor::MeshPropertyName);
+				LocalInvalid += Plan.Property != MeshProperty;
+				++LocalReads;
+			}
+			NumReads += LocalReads;
+			NumInvalid += LocalInvalid;
+		}));
+	}
+
+	for (int32 Iteration = 0; Iteration < 1000; ++Iteration)
+	{
+		FBlueprintComponentReferenceCache::Reset();
+		NumInvalid += FBlueprintComponentReferenceCache::FindPlan(ABCRCachedTestActor::StaticClass(), ABCRCachedTestActor::MeshPropertyName).Property != MeshProperty;
+	}
+
+	bStop = true;
+	for (TFuture<void>& Worker : Workers)
+	{
+		Worker.Wait();
+	}
+
+	TestTrueExpr(NumInvalid.load() == 0);
+	TestTrueExpr(NumReads.load() > 0);
+
+	// releases retired snapshots
+	FBlueprintComponentReferenceCache::PruneStaleEntries();
+	TestTrueExpr(FBlueprintComponentReferenceCache::FindPlan(ABCRCachedTestActor::StaticClass(), ABCRCachedTestActor::MeshPropertyName).Property == MeshProperty);
+
+	// other names are answered by plans built with the class
+	TestTrueExpr(FBlueprintComponentReferenceCache::FindPlan(ABCRCachedTestActor::StaticClass(), TEXT("RootComponent")).IsValid());
+	TestTrueExpr(!FBlueprintComponentReferenceCache::FindPlan(ABCRCachedTestActor::StaticClass(), TEXT("NotAProperty")).IsValid());
+
+	return true;
+}
+
 #define X_NAME_OF(x) TEXT(#x)
 // single prop sequential resolve vs direct
 template<int MaxNum>
@@ -164,9 +604,15 @@ struct PerfRunner_Single
 	TCachedComponentReference<USceneComponent, BCRDetails::TWeakPointerFuncs> CachedWeak;
 	
 	TCachedComponentReference<USceneComponent, BCRDetails::TWeakPointerFuncs> CachedWarm;
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	TCachedComponentReference<USceneComponent, BCRDetails::TObjectPtrFuncs> CachedObjectPtr;
+#endif
 	
 	PerfRunner_Single(AActor* InActor, const FBlueprintComponentReference& InRef)
 		: Actor(InActor), CachedStrong(InActor, &Ref), CachedWeak(InActor, &Ref), CachedWarm(InActor, &Ref)
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+		, CachedObjectPtr(InActor, &Ref)
+#endif
 	{
 		Ref = InRef;
 	}
@@ -201,6 +647,15 @@ struct PerfRunner_Single
 				CachedWeak.Get(Actor);
 			}
 		}
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("ObjectPtr")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 N = 0; N < MaxNum; ++N)
+			{
+				CachedObjectPtr.Get(Actor);
+			}
+		}
+#endif
 		
 		{
 			CachedWarm.Get(Actor);
@@ -226,9 +681,15 @@ struct PerfRunner_Array
 	TCachedComponentReferenceArray<USceneComponent, BCRDetails::TRawPointerFuncs> CachedStrong;
 	TCachedComponentReferenceArray<USceneComponent, BCRDetails::TWeakPointerFuncs> CachedWeak;
 	TCachedComponentReferenceArray<USceneComponent, BCRDetails::TWeakPointerFuncs> CachedWarm;
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	TCachedComponentReferenceArray<USceneComponent, BCRDetails::TObjectPtrFuncs> CachedObjectPtr;
+#endif
 	
 	PerfRunner_Array(AActor* InActor, const FBlueprintComponentReference& InRef)
 		: Actor(InActor), CachedStrong(InActor, &RefArray), CachedWeak(InActor, &RefArray), CachedWarm(InActor, &RefArray)
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+		, CachedObjectPtr(InActor, &RefArray)
+#endif
 	{
 		FRandomStream RandomStream( 0xC0FFEE );
 
@@ -248,7 +709,7 @@ struct PerfRunner_Array
 	
 	FString GenerateDescription(const TCHAR* AccessType)
 	{
-		return FString::Printf(TEXT("PerfRunner_Array [%-10s] [%-10s] %-8d access of %-8d"), AccessType, *Ref.ToString(), NumAccess, NumEntries);
+		return FString::Printf(TEXT("PerfRunner_Array [%-10s] [%-10s] %-8d access of %-8d [%-5d components]"), AccessType, *Ref.ToString(), NumAccess, NumEntries, Actor->GetComponents().Num());
 	}
 	
 	void Run()
@@ -260,6 +721,14 @@ struct PerfRunner_Array
 				RefArray[Index].GetComponent(Actor);
 			}
 		}
+		if (Ref.GetMode() == EBlueprintComponentReferenceMode::Path)
+		{ // object hash lookup that Path mode used before name index
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Hash")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Index : RefAccessSequence)
+			{
+				FindObjectFast<UActorComponent>(Actor, RefArray[Index].GetValue());
+			}
+		}
 		{
 			FScopeLogTime Scope(*GenerateDescription(TEXT("Strong")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
 			for (int32 Index : RefAccessSequence)
@@ -274,6 +743,15 @@ struct PerfRunner_Array
 				CachedWeak.Get(Actor, Index);
 			}
 		}
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("ObjectPtr")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Index : RefAccessSequence)
+			{
+				CachedObjectPtr.Get(Actor, Index);
+			}
+		}
+#endif
 		{
 			CachedWarm.GetAll(Actor);
 			
@@ -381,89 +859,887 @@ struct PerfRunner_MapKey
 	}
 };
 
-IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintComponentReferenceTests_Perf,
-	"BlueprintComponentReference.Perf", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
-
-bool FBlueprintComponentReferenceTests_Perf::RunTest(FString const&)
+// random map key access through blueprint map search, linear vs indexed
+template<int32 NumComponents, int32 NumEntries, int NumAccess>
+struct PerfRunner_MapKeyBlueprint
 {
-	FTestWorldScope World;
+	ABCRCachedTestActor* Actor;
+	const FMapProperty* MapProperty;
+	IConsoleVariable* UseIndexVar;
 
-	auto* TestActor = World->SpawnActor<ABCRCachedTestActor>();
-	TestTrueExpr(TestActor != nullptr);
-	TestActor->ReferenceSingle.Invalidate();
-	TestActor->ReferenceArray.Empty();
-	TestActor->ReferenceMap.Empty();
-	TestActor->ReferenceMapKey.Empty();
+	TArray<UActorComponent*> Components;
+	TArray<UActorComponent*> ComponentsInUse;
+	TArray<UActorComponent*> RefAccessSequence;
 
-	const auto BY_PROPERTY = FBlueprintComponentReference::ForProperty(ABCRCachedTestActor::MeshPropertyName);
-	const auto BY_PATH = FBlueprintComponentReference::ForPath(ABCRCachedTestActor::MeshComponentName);
+	PerfRunner_MapKeyBlueprint(ABCRCachedTestActor* InActor)
+		: Actor(InActor)
+	{
+		MapProperty = FindFProperty<FMapProperty>(ABCRCachedTestActor::StaticClass(), GET_MEMBER_NAME_CHECKED(ABCRCachedTestActor, ReferenceMapKey));
+		UseIndexVar = IConsoleManager::Get().FindConsoleVariable(TEXT("BCR.UseContainerIndex"));
 
-	//======================================
-	PerfRunner_Single<100>{ TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Single<1000>{ TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Single<10000>{ TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Single<100000>{ TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Single<1000000>{ TestActor, BY_PROPERTY }.Run();
-	//======================================
-	PerfRunner_Single<100>{ TestActor, BY_PATH }.Run();
-	PerfRunner_Single<1000>{ TestActor, BY_PATH }.Run();
-	PerfRunner_Single<10000>{ TestActor, BY_PATH }.Run();
-	PerfRunner_Single<100000>{ TestActor, BY_PATH }.Run();
-	PerfRunner_Single<1000000>{ TestActor, BY_PATH }.Run();
-	//======================================
-	PerfRunner_Array<1, 100> { TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Array<1, 1000> { TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Array<1, 10000> { TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Array<1, 100000> { TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Array<1, 1000000> { TestActor, BY_PROPERTY }.Run();
+		FRandomStream RandomStream( 0xC0FFEE );
 
-	PerfRunner_Array<10, 100> { TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Array<10, 1000> { TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Array<10, 10000> { TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Array<10, 100000> { TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Array<10, 1000000> { TestActor, BY_PROPERTY }.Run();
+		// setup components for test
+		Components.Reserve(NumComponents + 10);
+		InActor->GetComponents(UBCRTestSceneComponent::StaticClass(), Components);
+		while (Components.Num() < NumComponents)
+		{
+			auto* Component = NewObject<UBCRTestSceneComponent>(InActor);
+			Component->SetupAttachment(InActor->GetRootComponent());
+			Component->RegisterComponent();
+			Components.Add(Component);
+		}
 
-	PerfRunner_Array<100, 100> { TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Array<100, 1000> { TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Array<100, 10000> { TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Array<100, 100000> { TestActor, BY_PROPERTY }.Run();
-	PerfRunner_Array<100, 1000000> { TestActor, BY_PROPERTY }.Run();
-	//======================================
-	PerfRunner_Array<1, 100> { TestActor, BY_PATH }.Run();
-	PerfRunner_Array<1, 1000> { TestActor, BY_PATH }.Run();
-	PerfRunner_Array<1, 10000> { TestActor, BY_PATH }.Run();
-	PerfRunner_Array<1, 100000> { TestActor, BY_PATH }.Run();
-	PerfRunner_Array<1, 1000000> { TestActor, BY_PATH }.Run();
+		// setup map contents
+		InActor->ReferenceMapKey.Empty();
+		ComponentsInUse.Reserve(NumEntries);
+		while (InActor->ReferenceMapKey.Num() < NumEntries)
+		{
+			UActorComponent* Target = Components[RandomStream.RandHelper(Components.Num())];
 
-	PerfRunner_Array<10, 100> { TestActor, BY_PATH }.Run();
-	PerfRunner_Array<10, 1000> { TestActor, BY_PATH }.Run();
-	PerfRunner_Array<10, 10000> { TestActor, BY_PATH }.Run();
-	PerfRunner_Array<10, 100000> { TestActor, BY_PATH }.Run();
-	PerfRunner_Array<10, 1000000> { TestActor, BY_PATH }.Run();
+			FBCRTestStrustData Data;
+			Data.Sample = Target->GetFName();
+			InActor->ReferenceMapKey.Add(FBlueprintComponentReference::ForPath(Target->GetFName()), Data);
 
-	PerfRunner_Array<100, 100> { TestActor, BY_PATH }.Run();
-	PerfRunner_Array<100, 1000> { TestActor, BY_PATH }.Run();
-	PerfRunner_Array<100, 10000> { TestActor, BY_PATH }.Run();
-	PerfRunner_Array<100, 100000> { TestActor, BY_PATH }.Run();
-	PerfRunner_Array<100, 1000000> { TestActor, BY_PATH }.Run();
-	//======================================
-	PerfRunner_MapKey<10, 1, 100> { TestActor }.Run();
-	PerfRunner_MapKey<10, 1, 1000> { TestActor }.Run();
-	PerfRunner_MapKey<10, 1, 10000> { TestActor }.Run();
-	PerfRunner_MapKey<10, 1, 100000> { TestActor }.Run();
-	PerfRunner_MapKey<10, 1, 1000000> { TestActor }.Run();
-	
-	PerfRunner_MapKey<100, 10, 100> { TestActor }.Run();
-	PerfRunner_MapKey<100, 10, 1000> { TestActor }.Run();
-	PerfRunner_MapKey<100, 10, 10000> { TestActor }.Run();
-	PerfRunner_MapKey<100, 10, 100000> { TestActor }.Run();
-	PerfRunner_MapKey<100, 10, 1000000> { TestActor }.Run();
+			ComponentsInUse.AddUnique(Target);
+		}
 
-	PerfRunner_MapKey<100, 50, 100> { TestActor }.Run();
-	PerfRunner_MapKey<100, 50, 1000> { TestActor }.Run();
-	PerfRunner_MapKey<100, 50, 10000> { TestActor }.Run();
-	PerfRunner_MapKey<100, 50, 100000> { TestActor }.Run();
-	PerfRunner_MapKey<100, 50, 1000000> { TestActor }.Run();
+		// setup search sequence
+		RefAccessSequence.Reserve(NumAccess);
+		for (int32 Idx = 0; Idx < NumAccess; ++Idx)
+		{
+			RefAccessSequence.Add( ComponentsInUse[ RandomStream.RandHelper(ComponentsInUse.Num()) ]  );
+		}
+	}
+
+	FString GenerateDescription(const TCHAR* AccessType)
+	{
+		return FString::Printf(TEXT("PerfRunner_MapKeyBlueprint [%-10s] %-8d access of %-8d/%-8d"), AccessType, NumAccess, NumEntries, NumComponents);
+	}
+
+	void RunWith(const TCHAR* AccessType, bool bUseIndex)
+	{
+		UseIndexVar->Set(bUseIndex, ECVF_SetByCode);
+
+		FBCRTestStrustData Value;
+		FScopeLogTime Scope(*GenerateDescription(AccessType), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+		for (UActorComponent* Component : RefAccessSequence)
+		{
+			FBlueprintComponentReferenceLibraryTestAccess::Map_FindComponent(&Actor->ReferenceMapKey, MapProperty, Component, &Value);
+		}
+	}
+
+	void Run()
+	{
+		const bool bWasEnabled = UseIndexVar->GetBool();
+		RunWith(TEXT("Linear"), false);
+		RunWith(TEXT("Indexed"), true);
+		UseIndexVar->Set(bWasEnabled, ECVF_SetByCode);
+
+		Actor->ReferenceMapKey.Empty();
+	}
+};
+
+// repeated blueprint batch getter calls into same output variable, previous implementation vs library
+template<int32 NumEntries, int32 NumCalls>
+struct PerfRunner_BatchGetters
+{
+	AActor* Actor;
+	FBlueprintComponentReference Ref;
+	TArray<FBlueprintComponentReference> References;
+	TSet<FBlueprintComponentReference> ReferenceSet;
+
+	PerfRunner_BatchGetters(AActor* InActor, const FBlueprintComponentReference& InRef)
+		: Actor(InActor), Ref(InRef)
+	{
+		References.Init(InRef, NumEntries);
+
+		TArray<UActorComponent*> Components;
+		InActor->GetComponents(Components);
+		for (int32 Idx = 0; Idx < NumEntries && Idx < Components.Num(); ++Idx)
+		{
+			ReferenceSet.Add(FBlueprintComponentReference::ForPath(Components[Idx]->GetFName()));
+		}
+	}
+
+	FString GenerateDescription(const TCHAR* AccessType, int32 NumReallocs)
+	{
+		return FString::Printf(TEXT("PerfRunner_BatchGetters [%-10s] [%-10s] %-8d calls of %-8d, %.3f of calls reallocated output"),
+			AccessType, *Ref.ToString(), NumCalls, NumEntries, (float)NumReallocs / NumCalls);
+	}
+
+	/**
+	 * Allocation of output storage, compared at call boundaries on every path so numbers are comparable:
+	 * a call is counted once if storage was released, moved or resized anywhere within it.
+	 * Old paths are also sampled right after their Empty, a block freed there may be handed back unchanged by allocator.
+	 */
+	struct FStorageState
+	{
+		SIZE_T Size = 0;
+		const void* Data = nullptr;
+
+		bool operator!=(const FStorageState& Other) const
+		{
+			return Size != Other.Size || Data != Other.Data;
+		}
+	};
+
+	static FStorageState GetStorage(const TArray<UActorComponent*>& Output)
+	{
+		return { Output.GetAllocatedSize(), Output.GetData() };
+	}
+
+	static FStorageState GetStorage(const TSet<UActorComponent*>& Output)
+	{
+		// set elements are not contiguous, size change is the only observable reallocation
+		return { Output.GetAllocatedSize(), nullptr };
+	}
+
+	// each function returns whether output storage was reallocated during call
+	template<typename TFunc>
+	void RunCounted(const TCHAR* AccessType, TFunc&& Func)
+	{
+		int32 NumReallocs = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			NumReallocs += Func() ? 1 : 0;
+		}
+		const double Elapsed = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		UE_LOG(LogTemp, Log, TEXT("%s: %.3f ms"), *GenerateDescription(AccessType, NumReallocs), Elapsed);
+	}
+
+	void Run()
+	{
+		{
+			TArray<UActorComponent*> Components;
+			RunCounted(TEXT("ArrayOld"), [this, &Components]()
+			{
+				const FStorageState Before = GetStorage(Components);
+				Components.Empty();
+				bool bReallocated = GetStorage(Components) != Before;
+				for (const FBlueprintComponentReference& Reference : References)
+				{
+					UActorComponent* Component = Reference.GetComponent(Actor);
+					if (Component && Component->IsA(USceneComponent::StaticClass()))
+					{
+						Components.Add(Component);
+					}
+				}
+				return bReallocated || GetStorage(Components) != Before;
+			});
+		}
+		{
+			TArray<UActorComponent*> Components;
+			RunCounted(TEXT("Array"), [this, &Components]()
+			{
+				const FStorageState Before = GetStorage(Components);
+				UBlueprintComponentReferenceLibrary::GetReferencedComponents(References, Actor, USceneComponent::StaticClass(), false, Components);
+				return GetStorage(Components) != Before;
+			});
+		}
+		{
+			TSet<UActorComponent*> Components;
+			RunCounted(TEXT("SetOld"), [this, &Components]()
+			{
+				const FStorageState Before = GetStorage(Components);
+				Components.Empty();
+				bool bReallocated = GetStorage(Components) != Before;
+				for (const FBlueprintComponentReference& Reference : ReferenceSet)
+				{
+					UActorComponent* Component = Reference.GetComponent(Actor);
+					if (Component && Component->IsA(UActorComponent::StaticClass()))
+					{
+						Components.Add(Component);
+					}
+				}
+				return bReallocated || GetStorage(Components) != Before;
+			});
+		}
+		{
+			TSet<UActorComponent*> Components;
+			RunCounted(TEXT("Set"), [this, &Components]()
+			{
+				const FStorageState Before = GetStorage(Components);
+				UBlueprintComponentReferenceLibrary::GetSetReferencedComponents(ReferenceSet, Actor, UActorComponent::StaticClass(), Components);
+				return GetStorage(Components) != Before;
+			});
+		}
+	}
+};
+
+// replicated reference array payload, generic per property serialization vs NetSerialize
+template<int32 NumEntries>
+struct PerfRunner_NetSerialize
+{
+	TArray<FBlueprintComponentReference> References;
+
+	PerfRunner_NetSerialize(AActor* InActor)
+	{
+		TArray<UActorComponent*> Components;
+		InActor->GetComponents(Components);
+
+		FRandomStream RandomStream( 0xC0FFEE );
+		References.Reserve(NumEntries);
+		for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+		{
+			const FName Name = Components[RandomStream.RandHelper(Components.Num())]->GetFName();
+			switch (Idx % 4)
+			{
+			case 0: References.Add(FBlueprintComponentReference::ForProperty(Name)); break;
+			case 1: References.Add(FBlueprintComponentReference::ForPath(Name)); break;
+			case 2: References.Add(FBlueprintComponentReference::ForProperty(ACharacter::MeshComponentName)); break;
+			default: References.Add(FBlueprintComponentReference()); break;
+			}
+		}
+	}
+
+	FString GenerateDescription(const TCHAR* AccessType, int64 NumBits)
+	{
+		return FString::Printf(TEXT("PerfRunner_NetSerialize [%-10s] %-8d entries %-10lld bits %.2f bits per entry"),
+			AccessType, NumEntries, NumBits, (double)NumBits / NumEntries);
+	}
+
+	void Run()
+	{
+		UScriptStruct* const Struct = StaticStruct<FBlueprintComponentReference>();
+		{
+			FNetBitWriter Writer(nullptr, 1024);
+			const double StartTime = FPlatformTime::Seconds();
+			for (FBlueprintComponentReference& Reference : References)
+			{
+				for (TFieldIterator<FProperty> It(Struct); It; ++It)
+				{
+					It->NetSerializeItem(Writer, nullptr, It->ContainerPtrToValuePtr<void>(&Reference));
+				}
+			}
+			const double Elapsed = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			UE_LOG(LogTemp, Log, TEXT("%s: %.3f ms"), *GenerateDescription(TEXT("Generic"), Writer.GetNumBits()), Elapsed);
+		}
+		{
+			FNetBitWriter Writer(nullptr, 1024);
+			const double StartTime = FPlatformTime::Seconds();
+			for (FBlueprintComponentReference& Reference : References)
+			{
+				bool bSuccess = false;
+				Reference.NetSerialize(Writer, nullptr, bSuccess);
+			}
+			const double Elapsed = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			UE_LOG(LogTemp, Log, TEXT("%s: %.3f ms"), *GenerateDescription(TEXT("Compact"), Writer.GetNumBits()), Elapsed);
+		}
+	}
+};
+
+// text export and import of large reference array, compact form vs struct form
+template<int32 NumEntries>
+struct PerfRunner_Text
+{
+	const FArrayProperty* ArrayProperty;
+	TArray<FBlueprintComponentReference> References;
+	FString StructText;
+
+	PerfRunner_Text()
+	{
+		ArrayProperty = FindFProperty<FArrayProperty>(ABCRCachedTestActor::StaticClass(), GET_MEMBER_NAME_CHECKED(ABCRCachedTestActor, ReferenceArray));
+
+		References.Reserve(NumEntries);
+		StructText.Reserve(NumEntries * 48);
+		StructText += TEXT("(");
+		for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+		{
+			const FName Name(TEXT("Component"), Idx);
+			References.Add(Idx % 2 ? FBlueprintComponentReference::ForPath(Name) : FBlueprintComponentReference::ForProperty(Name));
+
+			StructText += Idx ? TEXT(",") : TEXT("");
+			StructText += FString::Printf(TEXT("(Mode=%s,Value=\"%s\")"), Idx % 2 ? TEXT("Path") : TEXT("Property"), *Name.ToString());
+		}
+		StructText += TEXT(")");
+	}
+
+	FString GenerateDescription(const TCHAR* AccessType)
+	{
+		return FString::Printf(TEXT("PerfRunner_Text [%-10s] %-8d entries"), AccessType, NumEntries);
+	}
+
+	void Import(const TCHAR* Text, TArray<FBlueprintComponentReference>& Loaded)
+	{
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+		ArrayProperty->ImportText(Text, &Loaded, PPF_None, nullptr);
+#else
+		ArrayProperty->ImportText_Direct(Text, &Loaded, nullptr, PPF_None);
+#endif
+	}
+
+	void Run()
+	{
+		FString CompactText;
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Export")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			ArrayProperty->ExportText_Direct(CompactText, &References, nullptr, nullptr, PPF_None);
+		}
+		{
+			TArray<FBlueprintComponentReference> Loaded;
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Import")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			Import(*CompactText, Loaded);
+		}
+		{
+			TArray<FBlueprintComponentReference> Loaded;
+			FScopeLogTime Scope(*GenerateDescription(TEXT("ImportOld")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			Import(*StructText, Loaded);
+		}
+		UE_LOG(LogTemp, Log, TEXT("PerfRunner_Text %d entries text size compact=%d struct=%d"), NumEntries, CompactText.Len(), StructText.Len());
+	}
+};
+
+// bulk parsing of references from strings, split based parsing vs string view parsing
+template<int32 NumEntries>
+struct PerfRunner_Parse
+{
+	TArray<FString> Sources;
+	TArray<FBlueprintComponentReference> Results;
+
+	PerfRunner_Parse()
+	{
+		Sources.Reserve(NumEntries);
+		for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+		{
+			// load time data references a limited set of components
+			Sources.Add(FString::Printf(Idx % 2 ? TEXT("path:Component_%d") : TEXT("property:Component_%d"), Idx % 100));
+		}
+		Results.SetNum(NumEntries);
+	}
+
+	FString GenerateDescription(const TCHAR* AccessType)
+	{
+		return FString::Printf(TEXT("PerfRunner_Parse [%-10s] %-8d entries"), AccessType, NumEntries);
+	}
+
+	static FBlueprintComponentReference SplitParse(const FString& InValue)
+	{
+		FString ParsedMode, ParsedValue;
+		if (InValue.Split(TEXT(":"), &ParsedMode, &ParsedValue, ESearchCase::CaseSensitive))
+		{
+			if (ParsedMode.Equals(TEXT("property"), ESearchCase::IgnoreCase))
+			{
+				return FBlueprintComponentReference::ForProperty(*ParsedValue.TrimEnd());
+			}
+			if (ParsedMode.Equals(TEXT("path"), ESearchCase::IgnoreCase))
+			{
+				return FBlueprintComponentReference::ForPath(*ParsedValue.TrimEnd());
+			}
+		}
+		return FBlueprintComponentReference();
+	}
+
+	void Run()
+	{
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Split")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+			{
+				Results[Idx] = SplitParse(Sources[Idx]);
+			}
+		}
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("View")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+			{
+				Results[Idx].ParseString(Sources[Idx]);
+			}
+		}
+		{
+			TStringBuilder<64> Builder;
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Append")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+			{
+				Builder.Reset();
+				Results[Idx].AppendString(Builder);
+			}
+		}
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("ToString")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+			{
+				Sources[Idx] = Results[Idx].ToString();
+			}
+		}
+	}
+};
+
+// binary save and load of data asset with many references, compact serializer vs tagged properties
+template<int32 NumEntries>
+struct PerfRunner_AssetSerialize
+{
+	UBCRTestDataAsset* Asset;
+
+	PerfRunner_AssetSerialize()
+	{
+		Asset = NewObject<UBCRTestDataAsset>(GetTransientPackage());
+		Asset->ReferenceArray.Reserve(NumEntries);
+		for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+		{
+			const FName Name(TEXT("Component"), Idx % 100);
+			Asset->ReferenceArray.Add(Idx % 2 ? FBlueprintComponentReference::ForPath(Name) : FBlueprintComponentReference::ForProperty(Name));
+		}
+	}
+
+	FString GenerateDescription(const TCHAR* AccessType)
+	{
+		return FString::Printf(TEXT("PerfRunner_AssetSerialize [%-10s] %-8d entries"), AccessType, NumEntries);
+	}
+
+	void Run()
+	{
+		UScriptStruct* const Struct = StaticStruct<FBlueprintComponentReference>();
+
+		TArray<uint8> CompactBytes;
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Save")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			FObjectWriter Writer(Asset, CompactBytes);
+		}
+		{
+			UBCRTestDataAsset* Loaded = NewObject<UBCRTestDataAsset>(GetTransientPackage());
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Load")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			FObjectReader Reader(Loaded, CompactBytes);
+		}
+
+		TArray<uint8> TaggedBytes;
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("SaveTagged")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			FMemoryWriter Writer(TaggedBytes);
+			for (FBlueprintComponentReference& Reference : Asset->ReferenceArray)
+			{
+				Struct->SerializeTaggedProperties(Writer, reinterpret_cast<uint8*>(&Reference), Struct, nullptr);
+			}
+		}
+		{
+			TArray<FBlueprintComponentReference> Loaded;
+			Loaded.SetNum(NumEntries);
+			FScopeLogTime Scope(*GenerateDescription(TEXT("LoadTagged")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			FMemoryReader Reader(TaggedBytes);
+			for (FBlueprintComponentReference& Reference : Loaded)
+			{
+				Struct->SerializeTaggedProperties(Reader, reinterpret_cast<uint8*>(&Reference), Struct, nullptr);
+			}
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("PerfRunner_AssetSerialize %d entries size compact=%d tagged=%d (names as strings)"), NumEntries, CompactBytes.Num(), TaggedBytes.Num());
+	}
+};
+
+// resolve every reference declared on actor, reflection walk vs precomputed schema
+template<int32 NumPasses>
+struct PerfRunner_Schema
+{
+	TArray<AActor*> Actors;
+
+	PerfRunner_Schema(const TArray<AActor*>& InActors) : Actors(InActors)
+	{
+	}
+
+	FString GenerateDescription(const TCHAR* AccessType)
+	{
+		return FString::Printf(TEXT("PerfRunner_Schema [%-10s] %-4d actors %-8d passes"), AccessType, Actors.Num(), NumPasses);
+	}
+
+	void Run()
+	{
+		UScriptStruct* const Struct = StaticStruct<FBlueprintComponentReference>();
+		int32 NumFields = 0;
+		int32 NumSchema = 0;
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Fields")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+			{
+				for (AActor* Actor : Actors)
+				{
+					for (TPropertyValueIterator<FStructProperty> It(Actor->GetClass(), Actor); It; ++It)
+					{
+						if (It.Key()->Struct == Struct)
+						{
+							NumFields += static_cast<const FBlueprintComponentReference*>(It.Value())->GetComponent(Actor) != nullptr;
+						}
+					}
+				}
+			}
+		}
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Schema")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+			{
+				for (AActor* Actor : Actors)
+				{
+					NumSchema += FComponentReferenceSchema::WarmupActor(Actor);
+				}
+			}
+		}
+		UE_LOG(LogTemp, Log, TEXT("PerfRunner_Schema resolved fields=%d schema=%d"), NumFields, NumSchema);
+	}
+};
+
+// single reference resolved against many actors, direct vs batched vs parallel chunks
+template<int32 NumEntries>
+struct PerfRunner_Parallel
+{
+	FBlueprintComponentReference Ref;
+	TArray<AActor*> Actors;
+	TArray<UActorComponent*> Results;
+
+	PerfRunner_Parallel(const TArray<AActor*>& InActors, const FBlueprintComponentReference& InRef)
+		: Ref(InRef)
+	{
+		Actors.Reserve(NumEntries);
+		for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+		{
+			Actors.Add(InActors[Idx % InActors.Num()]);
+		}
+		Results.SetNumZeroed(NumEntries);
+	}
+
+	FString GenerateDescription(const TCHAR* AccessType, int32 NumChunks = 1)
+	{
+		return FString::Printf(TEXT("PerfRunner_Parallel [%-10s] [%-10s] %-8d actors %-3d chunks"), AccessType, *Ref.ToString(), NumEntries, NumChunks);
+	}
+
+	void Run()
+	{
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Direct")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+			{
+				Results[Idx] = Ref.GetComponent(Actors[Idx]);
+			}
+		}
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Batch")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			UBlueprintComponentReferenceLibrary::ResolveComponentsBatch(MakeArrayView(&Ref, 1), Actors, Results);
+		}
+
+		// 1, 2, 4 ... chunks up to one per worker thread
+		const int32 MaxChunks = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+		TArray<int32> ChunkCounts;
+		for (int32 NumChunks = 1; NumChunks < MaxChunks; NumChunks *= 2)
+		{
+			ChunkCounts.Add(NumChunks);
+		}
+		ChunkCounts.Add(MaxChunks);
+
+		for (int32 NumChunks : ChunkCounts)
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Parallel"), NumChunks), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			UBlueprintComponentReferenceLibrary::ResolveComponentsParallel(MakeArrayView(&Ref, 1), Actors, Results, NumChunks);
+		}
+	}
+};
+
+// reference construction on hot path, runtime name vs literal
+template<int32 NumEntries>
+struct PerfRunner_Literal
+{
+	AActor* Actor;
+
+	PerfRunner_Literal(AActor* InActor) : Actor(InActor)
+	{
+	}
+
+	FString GenerateDescription(const TCHAR* AccessType)
+	{
+		return FString::Printf(TEXT("PerfRunner_Literal [%-10s] %-8d entries"), AccessType, NumEntries);
+	}
+
+	void Run()
+	{
+		int32 NumFound = 0;
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Construct")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+			{
+				NumFound += FBlueprintComponentReference::ForProperty(TEXT("Mesh")).GetComponent(Actor) != nullptr;
+			}
+		}
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("Literal")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+			{
+				NumFound += BCR_PROPERTY_LITERAL("Mesh").GetComponent(Actor) != nullptr;
+			}
+		}
+		UE_LOG(LogTemp, Log, TEXT("PerfRunner_Literal found=%d"), NumFound);
+	}
+};
+
+// dynamic selection, linear scan of owned components vs per-actor index
+template<int32 NumEntries>
+struct PerfRunner_Dynamic
+{
+	AActor* Actor;
+	FName Tag;
+	FBlueprintComponentReference ByTag;
+	FBlueprintComponentReference ByClass;
+
+	PerfRunner_Dynamic(AActor* InActor, FName InTag, const UClass* InClass)
+		: Actor(InActor), Tag(InTag), ByTag(FBlueprintComponentReference::ForTag(InTag)), ByClass(FBlueprintComponentReference::ForClass(InClass))
+	{
+	}
+
+	FString GenerateDescription(const TCHAR* AccessType)
+	{
+		return FString::Printf(TEXT("PerfRunner_Dynamic [%-10s] %-4d components %-8d entries"), AccessType, Actor->GetComponents().Num(), NumEntries);
+	}
+
+	void Run()
+	{
+		const UClass* Class = FBlueprintComponentReferenceCache::FindSelector(ByClass.GetValue()).Class.Get();
+		int32 NumFound = 0;
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("ScanTag")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+			{
+				for (UActorComponent* Component : Actor->GetComponents())
+				{
+					if (Component && Component->ComponentHasTag(Tag))
+					{
+						++NumFound;
+						break;
+					}
+				}
+			}
+		}
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("IndexTag")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+			{
+				NumFound += ByTag.GetComponent(Actor) != nullptr;
+			}
+		}
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("ScanClass")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+			{
+				NumFound += Actor->FindComponentByClass(const_cast<UClass*>(Class)) != nullptr;
+			}
+		}
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("IndexClass")), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			for (int32 Idx = 0; Idx < NumEntries; ++Idx)
+			{
+				NumFound += ByClass.GetComponent(Actor) != nullptr;
+			}
+		}
+		UE_LOG(LogTemp, Log, TEXT("PerfRunner_Dynamic found=%d"), NumFound);
+	}
+};
+
+// property lookup from many threads at once, reflection search vs global plan cache
+template<int32 NumLookups>
+struct PerfRunner_PlanLookup
+{
+	const UClass* Class;
+	FName Name;
+
+	PerfRunner_PlanLookup(const UClass* InClass, FName InName) : Class(InClass), Name(InName)
+	{
+	}
+
+	FString GenerateDescription(const TCHAR* AccessType, int32 NumThreads)
+	{
+		return FString::Printf(TEXT("PerfRunner_PlanLookup [%-10s] [%-10s] %-8d lookups %-3d threads"), AccessType, *Name.ToString(), NumLookups, NumThreads);
+	}
+
+	void Run()
+	{
+		const int32 NumThreads = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+		const int32 PerThread = NumLookups / NumThreads;
+		std::atomic<int32> NumFound { 0 };
+
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("FindFProp"), NumThreads), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			ParallelFor(NumThreads, [this, PerThread, &NumFound](int32)
+			{
+				int32 Found = 0;
+				for (int32 N = 0; N < PerThread; ++N)
+				{
+					Found += FindFProperty<FObjectPropertyBase>(Class, Name) != nullptr;
+				}
+				NumFound += Found;
+			});
+		}
+
+		FBlueprintComponentReferenceCache::FindPlan(Class, Name);
+		{
+			FScopeLogTime Scope(*GenerateDescription(TEXT("FindPlan"), NumThreads), nullptr, FConditionalScopeLogTime::ScopeLog_Milliseconds);
+			ParallelFor(NumThreads, [this, PerThread, &NumFound](int32)
+			{
+				int32 Found = 0;
+				for (int32 N = 0; N < PerThread; ++N)
+				{
+					Found += FBlueprintComponentReferenceCache::FindPlan(Class, Name).IsValid();
+				}
+				NumFound += Found;
+			});
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("PerfRunner_PlanLookup found=%d"), NumFound.load());
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintComponentReferenceTests_Perf,
+	"BlueprintComponentReference.Perf", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+
+bool FBlueprintComponentReferenceTests_Perf::RunTest(FString const&)
+{
+	FTestWorldScope World;
+
+	auto* TestActor = World->SpawnActor<ABCRCachedTestActor>();
+	TestTrueExpr(TestActor != nullptr);
+	TestActor->ReferenceSingle.Invalidate();
+	TestActor->ReferenceArray.Empty();
+	TestActor->ReferenceMap.Empty();
+	TestActor->ReferenceMapKey.Empty();
+
+	const auto BY_PROPERTY = FBlueprintComponentReference::ForProperty(ABCRCachedTestActor::MeshPropertyName);
+	const auto BY_PATH = FBlueprintComponentReference::ForPath(ABCRCachedTestActor::MeshComponentName);
+
+	//======================================
+	PerfRunner_Single<100>{ TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Single<1000>{ TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Single<10000>{ TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Single<100000>{ TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Single<1000000>{ TestActor, BY_PROPERTY }.Run();
+	//======================================
+	PerfRunner_Single<100>{ TestActor, BY_PATH }.Run();
+	PerfRunner_Single<1000>{ TestActor, BY_PATH }.Run();
+	PerfRunner_Single<10000>{ TestActor, BY_PATH }.Run();
+	PerfRunner_Single<100000>{ TestActor, BY_PATH }.Run();
+	PerfRunner_Single<1000000>{ TestActor, BY_PATH }.Run();
+	//======================================
+	PerfRunner_Array<1, 100> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Array<1, 1000> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Array<1, 10000> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Array<1, 100000> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Array<1, 1000000> { TestActor, BY_PROPERTY }.Run();
+
+	PerfRunner_Array<10, 100> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Array<10, 1000> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Array<10, 10000> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Array<10, 100000> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Array<10, 1000000> { TestActor, BY_PROPERTY }.Run();
+
+	PerfRunner_Array<100, 100> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Array<100, 1000> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Array<100, 10000> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Array<100, 100000> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_Array<100, 1000000> { TestActor, BY_PROPERTY }.Run();
+	//======================================
+	PerfRunner_Array<1, 100> { TestActor, BY_PATH }.Run();
+	PerfRunner_Array<1, 1000> { TestActor, BY_PATH }.Run();
+	PerfRunner_Array<1, 10000> { TestActor, BY_PATH }.Run();
+	PerfRunner_Array<1, 100000> { TestActor, BY_PATH }.Run();
+	PerfRunner_Array<1, 1000000> { TestActor, BY_PATH }.Run();
+
+	PerfRunner_Array<10, 100> { TestActor, BY_PATH }.Run();
+	PerfRunner_Array<10, 1000> { TestActor, BY_PATH }.Run();
+	PerfRunner_Array<10, 10000> { TestActor, BY_PATH }.Run();
+	PerfRunner_Array<10, 100000> { TestActor, BY_PATH }.Run();
+	PerfRunner_Array<10, 1000000> { TestActor, BY_PATH }.Run();
+
+	PerfRunner_Array<100, 100> { TestActor, BY_PATH }.Run();
+	PerfRunner_Array<100, 1000> { TestActor, BY_PATH }.Run();
+	PerfRunner_Array<100, 10000> { TestActor, BY_PATH }.Run();
+	PerfRunner_Array<100, 100000> { TestActor, BY_PATH }.Run();
+	PerfRunner_Array<100, 1000000> { TestActor, BY_PATH }.Run();
+	//======================================
+	for (int32 NumComponents : { 10, 100, 1000 })
+	{
+		auto* LargeActor = World->SpawnActor<ABCRCachedTestActor>();
+		while (LargeActor->GetComponents().Num() < NumComponents)
+		{
+			auto* Component = NewObject<UBCRTestSceneComponent>(LargeActor);
+			Component->SetupAttachment(LargeActor->GetRootComponent());
+			Component->RegisterComponent();
+		}
+
+		PerfRunner_Array<10, 10000> { LargeActor, BY_PATH }.Run();
+		PerfRunner_Array<10, 100000> { LargeActor, BY_PATH }.Run();
+		PerfRunner_Array<10, 1000000> { LargeActor, BY_PATH }.Run();
+	}
+	//======================================
+	PerfRunner_MapKey<10, 1, 100> { TestActor }.Run();
+	PerfRunner_MapKey<10, 1, 1000> { TestActor }.Run();
+	PerfRunner_MapKey<10, 1, 10000> { TestActor }.Run();
+	PerfRunner_MapKey<10, 1, 100000> { TestActor }.Run();
+	PerfRunner_MapKey<10, 1, 1000000> { TestActor }.Run();
+	
+	PerfRunner_MapKey<100, 10, 100> { TestActor }.Run();
+	PerfRunner_MapKey<100, 10, 1000> { TestActor }.Run();
+	PerfRunner_MapKey<100, 10, 10000> { TestActor }.Run();
+	PerfRunner_MapKey<100, 10, 100000> { TestActor }.Run();
+	PerfRunner_MapKey<100, 10, 1000000> { TestActor }.Run();
+
+	PerfRunner_MapKey<100, 50, 100> { TestActor }.Run();
+	PerfRunner_MapKey<100, 50, 1000> { TestActor }.Run();
+	PerfRunner_MapKey<100, 50, 10000> { TestActor }.Run();
+	PerfRunner_MapKey<100, 50, 100000> { TestActor }.Run();
+	PerfRunner_MapKey<100, 50, 1000000> { TestActor }.Run();
+
+	PerfRunner_MapKeyBlueprint<10, 1, 1000> { TestActor }.Run();
+	PerfRunner_MapKeyBlueprint<10, 1, 100000> { TestActor }.Run();
+
+	PerfRunner_MapKeyBlueprint<100, 10, 1000> { TestActor }.Run();
+	PerfRunner_MapKeyBlueprint<100, 10, 100000> { TestActor }.Run();
+
+	PerfRunner_MapKeyBlueprint<100, 50, 1000> { TestActor }.Run();
+	PerfRunner_MapKeyBlueprint<100, 50, 100000> { TestActor }.Run();
+
+	PerfRunner_MapKeyBlueprint<1000, 500, 1000> { TestActor }.Run();
+	PerfRunner_MapKeyBlueprint<1000, 500, 100000> { TestActor }.Run();
+	//======================================
+	PerfRunner_BatchGetters<10, 10000> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_BatchGetters<100, 10000> { TestActor, BY_PROPERTY }.Run();
+	PerfRunner_BatchGetters<100, 10000> { TestActor, BY_PATH }.Run();
+	//======================================
+	PerfRunner_NetSerialize<100> { TestActor }.Run();
+	PerfRunner_NetSerialize<10000> { TestActor }.Run();
+	//======================================
+	PerfRunner_Text<1000> { }.Run();
+	PerfRunner_Text<10000> { }.Run();
+	//======================================
+	PerfRunner_Parse<100000> { }.Run();
+	//======================================
+	PerfRunner_Literal<100000> { TestActor }.Run();
+	PerfRunner_Literal<1000000> { TestActor }.Run();
+	//======================================
+	{
+		ABCRTestActor* DynamicActor = World->SpawnActor<ABCRTestActor>();
+		DynamicActor->Default_LevelTwo->ComponentTags.Add(TEXT("Weakpoint"));
+		FBlueprintComponentReferenceCache::InvalidateActor(DynamicActor);
+
+		PerfRunner_Dynamic<10000> { DynamicActor, TEXT("Weakpoint"), UBCRTestActorComponent::StaticClass() }.Run();
+		PerfRunner_Dynamic<100000> { DynamicActor, TEXT("Weakpoint"), UBCRTestActorComponent::StaticClass() }.Run();
+	}
+	//======================================
+	PerfRunner_AssetSerialize<50000> { }.Run();
+	//======================================
+	TArray<AActor*> SchemaActors;
+	while (SchemaActors.Num() < 100)
+	{
+		SchemaActors.Add(World->SpawnActor<ABCRTestActor>());
+	}
+
+	PerfRunner_Schema<100> { SchemaActors }.Run();
+	//======================================
+	TArray<AActor*> ParallelActors { TestActor };
+	while (ParallelActors.Num() < 16)
+	{
+		ParallelActors.Add(World->SpawnActor<ABCRCachedTestActor>());
+	}
+
+	PerfRunner_Parallel<10000> { ParallelActors, BY_PROPERTY }.Run();
+	PerfRunner_Parallel<100000> { ParallelActors, BY_PROPERTY }.Run();
+	PerfRunner_Parallel<1000000> { ParallelActors, BY_PROPERTY }.Run();
+	//======================================
+	PerfRunner_PlanLookup<100000> { ABCRCachedTestActor::StaticClass(), ABCRCachedTestActor::MeshPropertyName }.Run();
+	PerfRunner_PlanLookup<1000000> { ABCRCachedTestActor::StaticClass(), ABCRCachedTestActor::MeshPropertyName }.Run();
 	
 	return true;
 }
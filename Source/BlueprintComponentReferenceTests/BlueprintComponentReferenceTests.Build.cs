@@ -30,6 +30,11 @@ public class BlueprintComponentReferenceTests : ModuleRules
 			"BlueprintComponentReference",
 			"BlueprintComponentReferenceEditor"
 		});
+
+		PrivateDependencyModuleNames.AddRange(new string[] {
+			"UnrealEd",
+			"BlueprintGraph"
+		});
 		
 		if (Target.Version.MajorVersion >= 5)
 		{
@@ -7,18 +7,45 @@
 #include "BlueprintComponentReference.h"
 #include "BlueprintComponentReferenceLibrary.h"
 #include "BlueprintComponentReferenceMetadata.h"
+#include "BlueprintComponentReferenceCookValidator.h"
+#include "ComponentReferenceSchema.h"
+#include "BlueprintComponentReferenceSubsystem.h"
+#include "BCRTestStruct.h"
+#include "ResolvedComponentReferenceHandle.h"
+#include "ComponentReferenceLiteral.h"
+#include "BlueprintComponentReferenceCache.h"
 #include "GameFramework/Actor.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/DefaultPawn.h"
+#include "Components/ChildActorComponent.h"
+#include "Components/SphereComponent.h"
 #include "Stats/StatsMisc.h"
 #include "Misc/AutomationTest.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "UObject/CoreNet.h"
+#include "BlueprintComponentReferenceVersion.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Misc/EngineVersionComparison.h"
+#include "K2Node_GetReferencedComponent.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_VariableSet.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
 
 IMPLEMENT_MODULE(FDefaultModuleImpl, BlueprintComponentReferenceTests);
 
 #if WITH_DEV_AUTOMATION_TESTS
 
+BCR_DECLARE_PROPERTY_LITERAL(TestRootLiteral, ABCRTestActor, "Default_Root");
+BCR_DECLARE_PATH_LITERAL(TestLevelZeroLiteral, ABCRTestActor, "Default_LevelZero");
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintComponentReferenceTests_Core,
 	"BlueprintComponentReference.Core", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
 
@@ -67,6 +94,19 @@ bool FBlueprintComponentReferenceTests_Core::RunTest(FString const&)
 			TestTrueExpr(Sample0.ToString() == TEXT("path:Sample"));
 			TestTrueExpr(Sample1.ToString() == TEXT("path:Sample_10"));
 			TestTrueExpr(Sample2.ToString() == TEXT("path:Sample_21"));
+
+			TStringBuilder<64> Builder;
+			Builder.Append(TEXT("["));
+			Sample1.AppendString(Builder);
+			Builder.Append(TEXT("]"));
+			TestTrueExpr(FStringView(Builder) == TEXT("[path:Sample_10]"));
+
+			FBlueprintComponentReference Parsed;
+			TestTrueExpr(Parsed.ParseString(FStringView(Builder).Mid(1, Builder.Len() - 2)));
+			TestTrueExpr(Parsed == Sample1);
+			TestTrueExpr(!Parsed.ParseString(TEXT("")));
+			TestTrueExpr(!Parsed.ParseString(TEXT("unknown:Sample")));
+			TestTrueExpr(Parsed == Sample1);
 		}
 
 		{
@@ -121,6 +161,175 @@ bool FBlueprintComponentReferenceTests_Core::RunTest(FString const&)
 			TestTrueExpr(!RootReference.IsNull());
 			TestTrueExpr(RootReference.GetComponent(TestActor) == RootComponent);
 		}
+		{
+			FResolvedComponentReferenceHandle PropHandle(FBlueprintComponentReference(TEXT("property:Default_Root")), ABCRTestActor::StaticClass());
+			FResolvedComponentReferenceHandle PathHandle(FBlueprintComponentReference(TEXT("path:Construct_LevelOne_SomeName")), ABCRTestActor::StaticClass());
+			FResolvedComponentReferenceHandle OtherHandle(FBlueprintComponentReference(TEXT("property:Default_Root")), AActor::StaticClass());
+
+			TestTrueExpr(PropHandle.IsCompiledFor(ABCRTestActor::StaticClass()));
+			TestTrueExpr(PropHandle.GetComponent(TestActor) == TestRootComponent);
+			TestTrueExpr(PathHandle.GetComponent(TestActor) == LevelOneConstructNPComponent);
+			TestTrueExpr(OtherHandle.GetComponent(TestActor) == TestRootComponent);
+		}
+		{
+			TestTrueExpr(BCR_PROPERTY_LITERAL("Default_Root") == FBlueprintComponentReference::ForProperty(TEXT("Default_Root")));
+			TestTrueExpr(BCR_PATH_LITERAL("Default_LevelZero") == FBlueprintComponentReference::ForPath(TEXT("Default_LevelZero")));
+			TestTrueExpr(BCR_PROPERTY_LITERAL("Default_Root").GetComponent(TestActor) == TestRootComponent);
+
+			// same instance is returned for each evaluation of use site
+			const FBlueprintComponentReference* Instances[2];
+			for (int32 Index = 0; Index < 2; ++Index)
+			{
+				Instances[Index] = &BCR_PROPERTY_LITERAL("Default_Root");
+			}
+			TestTrueExpr(Instances[0] == Instances[1]);
+
+			TestTrueExpr(TestRootLiteral().GetComponent(TestActor) == TestRootComponent);
+			TestTrueExpr(TestLevelZeroLiteral().GetComponent(TestActor) == (TestActor ? TestActor->Default_LevelZero : nullptr));
+			TestTrueExpr(&TestRootLiteral() == &TestRootLiteral());
+
+			TestTrueExpr(FComponentReferenceLiterals::IsValidFor(TestRootLiteral(), ABCRTestActor::StaticClass()));
+			TestTrueExpr(FComponentReferenceLiterals::IsValidFor(TestLevelZeroLiteral(), ABCRTestActor::StaticClass()));
+			TestTrueExpr(!FComponentReferenceLiterals::IsValidFor(TestRootLiteral(), AActor::StaticClass()));
+			TestTrueExpr(!FComponentReferenceLiterals::IsValidFor(BCR_PATH_LITERAL("Non_Existent_Path"), ABCRTestActor::StaticClass()));
+			TestTrueExpr(!FComponentReferenceLiterals::IsValidFor(BCR_PROPERTY_LITERAL("NonExistingComponent"), ABCRTestActor::StaticClass()));
+			TestTrueExpr(FComponentReferenceLiterals::ValidateAll() == 0);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintComponentReferenceTests_Serialization,
+	"BlueprintComponentReference.Serialization", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FBlueprintComponentReferenceTests_Serialization::RunTest(FString const&)
+{
+	FName NumberedName = "Sample";
+	NumberedName.SetNumber(11);
+
+	const TArray<FBlueprintComponentReference> Samples {
+		FBlueprintComponentReference(),
+		FBlueprintComponentReference(TEXT("property:Default_Root")),
+		FBlueprintComponentReference(TEXT("path:Construct_LevelOne_SomeName")),
+		FBlueprintComponentReference::ForPath(NumberedName),
+		FBlueprintComponentReference::ForProperty(TEXT("RootComponent")),
+		FBlueprintComponentReference(TEXT("nested:LevelNope.CollisionComponent")),
+		FBlueprintComponentReference(TEXT("dynamic:Tag:Weakpoint")),
+		FBlueprintComponentReference::ForClass(USkeletalMeshComponent::StaticClass()),
+	};
+
+	{
+		FNetBitWriter Writer(nullptr, 1024);
+		for (FBlueprintComponentReference Sample : Samples)
+		{
+			bool bSuccess = false;
+			Sample.NetSerialize(Writer, nullptr, bSuccess);
+			TestTrueExpr(bSuccess);
+		}
+		TestTrueExpr(!Writer.IsError());
+
+		FNetBitReader Reader(nullptr, Writer.GetData(), Writer.GetNumBits());
+		for (const FBlueprintComponentReference& Sample : Samples)
+		{
+			FBlueprintComponentReference Loaded(TEXT("path:Garbage"));
+			bool bSuccess = false;
+			Loaded.NetSerialize(Reader, nullptr, bSuccess);
+			TestTrueExpr(bSuccess);
+			TestTrueExpr(Loaded == Sample);
+		}
+		TestTrueExpr(!Reader.IsError());
+		TestTrueExpr(Reader.AtEnd());
+	}
+
+	{
+		// unused mode values are rejected
+		FNetBitWriter Writer(nullptr, 64);
+		uint8 UnusedMode = 7;
+		Writer.SerializeBits(&UnusedMode, 3);
+
+		FNetBitReader Reader(nullptr, Writer.GetData(), Writer.GetNumBits());
+		FBlueprintComponentReference Loaded(TEXT("path:Garbage"));
+		bool bSuccess = true;
+		Loaded.NetSerialize(Reader, nullptr, bSuccess);
+		TestTrueExpr(!bSuccess);
+		TestTrueExpr(Loaded.IsNull());
+	}
+
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		for (FBlueprintComponentReference Sample : Samples)
+		{
+			TestTrueExpr(Sample.Serialize(Writer));
+		}
+
+		FMemoryReader Reader(Bytes);
+		for (const FBlueprintComponentReference& Sample : Samples)
+		{
+			FBlueprintComponentReference Loaded(TEXT("path:Garbage"));
+			TestTrueExpr(Loaded.Serialize(Reader));
+			TestTrueExpr(Loaded == Sample);
+		}
+		TestTrueExpr(!Reader.IsError());
+		TestTrueExpr(Reader.AtEnd());
+
+		// data saved before compact serialization goes through tagged properties
+		FMemoryReader OldReader(Bytes);
+		OldReader.SetCustomVersion(FBlueprintComponentReferenceVersion::GUID, FBlueprintComponentReferenceVersion::BeforeCustomVersionWasAdded, TEXT("BlueprintComponentReferenceVer"));
+		FBlueprintComponentReference Loaded;
+		TestTrueExpr(!Loaded.Serialize(OldReader));
+		TestTrueExpr(OldReader.Tell() == 0);
+	}
+
+	UScriptStruct* const Struct = StaticStruct<FBlueprintComponentReference>();
+	for (const FBlueprintComponentReference& Sample : Samples)
+	{
+		FString Text;
+		Struct->ExportText(Text, &Sample, nullptr, nullptr, PPF_None, nullptr);
+		TestTrueExpr(Sample.IsNull() || Text == Sample.ToString());
+
+		FBlueprintComponentReference Loaded(TEXT("path:Garbage"));
+		TestTrueExpr(Struct->ImportText(*Text, &Loaded, nullptr, PPF_None, nullptr, Struct->GetName()) != nullptr);
+		TestTrueExpr(Loaded == Sample);
+	}
+
+	{
+		// names with delimiters are quoted
+		const FBlueprintComponentReference Spaced = FBlueprintComponentReference::ForProperty(TEXT("My Mesh"));
+		FString Text;
+		Struct->ExportText(Text, &Spaced, nullptr, nullptr, PPF_None, nullptr);
+		TestTrueExpr(Text == TEXT("\"property:My Mesh\""));
+
+		FBlueprintComponentReference Loaded;
+		TestTrueExpr(Struct->ImportText(*Text, &Loaded, nullptr, PPF_None, nullptr, Struct->GetName()) != nullptr);
+		TestTrueExpr(Loaded == Spaced);
+	}
+
+	{
+		// struct form written before native text export is still readable
+		FBlueprintComponentReference Loaded;
+		TestTrueExpr(Struct->ImportText(TEXT("(Mode=Path,Value=\"Construct_LevelOne_SomeName\")"), &Loaded, nullptr, PPF_None, nullptr, Struct->GetName()) != nullptr);
+		TestTrueExpr(Loaded == FBlueprintComponentReference(TEXT("path:Construct_LevelOne_SomeName")));
+	}
+
+	{
+		// compact form inside of containers
+		const FArrayProperty* ArrayProperty = FindFProperty<FArrayProperty>(ABCRCachedTestActor::StaticClass(), GET_MEMBER_NAME_CHECKED(ABCRCachedTestActor, ReferenceArray));
+		TestTrueExpr(ArrayProperty != nullptr);
+
+		TArray<FBlueprintComponentReference> Loaded;
+		const TCHAR* Text = TEXT("(path:Sample_10,property:Default_Root,(Mode=Property,Value=\"Mesh\"),\"property:My Mesh\")");
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+		TestTrueExpr(ArrayProperty->ImportText(Text, &Loaded, PPF_None, nullptr) != nullptr);
+#else
+		TestTrueExpr(ArrayProperty->ImportText_Direct(Text, &Loaded, nullptr, PPF_None) != nullptr);
+#endif
+		TestTrueExpr(Loaded.Num() == 4);
+		TestTrueExpr(Loaded.Num() == 4 && Loaded[0] == FBlueprintComponentReference::ForPath(NumberedName));
+		TestTrueExpr(Loaded.Num() == 4 && Loaded[1] == FBlueprintComponentReference::ForProperty(TEXT("Default_Root")));
+		TestTrueExpr(Loaded.Num() == 4 && Loaded[2] == FBlueprintComponentReference::ForProperty(TEXT("Mesh")));
+		TestTrueExpr(Loaded.Num() == 4 && Loaded[3] == FBlueprintComponentReference::ForProperty(TEXT("My Mesh")));
 	}
 
 	return true;
@@ -187,6 +396,392 @@ bool FBlueprintComponentReferenceTests_Library::RunTest(FString const&)
 	TestFalse("Bad.GetReferencedComponent", UBlueprintComponentReferenceLibrary::GetReferencedComponent(BadReference, TestActorReal, nullptr, Result));
 	TestTrue("Bad.GetReferencedComponent.Result", Result == nullptr);
 
+	ABCRTestActor* const TestActorReal2 = World->SpawnActor<ABCRTestActor>();
+	TArray<AActor*> BatchActors { TestActorReal, TestActorNull, TestActorReal2 };
+	TArray<UActorComponent*> BatchResult;
+
+	UBlueprintComponentReferenceLibrary::GetReferencedComponentForActors(MeshVarReference, BatchActors, nullptr, BatchResult);
+	TestTrue("MeshVarReference.GetReferencedComponentForActors.Num", BatchResult.Num() == BatchActors.Num());
+	TestTrue("MeshVarReference.GetReferencedComponentForActors.0", BatchResult[0] == TestActorReal->GetMesh());
+	TestTrue("MeshVarReference.GetReferencedComponentForActors.1", BatchResult[1] == nullptr);
+	TestTrue("MeshVarReference.GetReferencedComponentForActors.2", BatchResult[2] == TestActorReal2->GetMesh());
+
+	UBlueprintComponentReferenceLibrary::GetReferencedComponentForActors(MeshVarReference, BatchActors, UStaticMeshComponent::StaticClass(), BatchResult);
+	TestTrue("MeshVarReference2.GetReferencedComponentForActors", BatchResult[0] == nullptr && BatchResult[2] == nullptr);
+
+	TArray<FBlueprintComponentReference> ContainsArray { TestBaseReference, BadReference };
+	TSet<FBlueprintComponentReference> ContainsSet { TestBaseReference, BadReference };
+
+	// references that resolve to another component must not count as a match
+	TestFalse("Array_ContainsComponent.Other", UBlueprintComponentReferenceLibrary::Array_ContainsComponent(ContainsArray, TestActorReal->GetMesh()));
+	TestFalse("Set_ContainsComponent.Other", UBlueprintComponentReferenceLibrary::Set_ContainsComponent(ContainsSet, TestActorReal->GetMesh()));
+	TestTrue("Array_ContainsComponent.Root", UBlueprintComponentReferenceLibrary::Array_ContainsComponent(ContainsArray, TestActorReal->Default_Root));
+	TestTrue("Set_ContainsComponent.Root", UBlueprintComponentReferenceLibrary::Set_ContainsComponent(ContainsSet, TestActorReal->Default_Root));
+	TestFalse("Array_ContainsComponent.OtherActor", UBlueprintComponentReferenceLibrary::Array_ContainsComponent(ContainsArray, TestActorReal2->GetMesh()));
+	TestFalse("Array_ContainsComponent.Null", UBlueprintComponentReferenceLibrary::Array_ContainsComponent(ContainsArray, nullptr));
+
+	// changes to container are picked up by cached lookup
+	ContainsArray[1] = MeshPathReference;
+	ContainsSet.Remove(BadReference);
+	ContainsSet.Add(MeshPathReference);
+	TestTrue("Array_ContainsComponent.Changed", UBlueprintComponentReferenceLibrary::Array_ContainsComponent(ContainsArray, TestActorReal->GetMesh()));
+	TestTrue("Set_ContainsComponent.Changed", UBlueprintComponentReferenceLibrary::Set_ContainsComponent(ContainsSet, TestActorReal->GetMesh()));
+	TestTrue("Array_ContainsComponent.OtherActor2", UBlueprintComponentReferenceLibrary::Array_ContainsComponent(ContainsArray, TestActorReal2->GetMesh()));
+
+	// property references are resolved once into lookup as well
+	TArray<FBlueprintComponentReference> PropertyArray { MeshVarReference, TestBaseReference };
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		TestTrue("Array_ContainsComponent.PropertyMesh", UBlueprintComponentReferenceLibrary::Array_ContainsComponent(PropertyArray, TestActorReal->GetMesh()));
+		TestTrue("Array_ContainsComponent.PropertyRoot", UBlueprintComponentReferenceLibrary::Array_ContainsComponent(PropertyArray, TestActorReal->Default_Root));
+		TestFalse("Array_ContainsComponent.PropertyOther", UBlueprintComponentReferenceLibrary::Array_ContainsComponent(PropertyArray, TestActorReal->GetCapsuleComponent()));
+	}
+
+	// reference schema
+	{
+		FBCRTestStruct SchemaStruct;
+		SchemaStruct.Reference = TestBaseReference;
+		SchemaStruct.ReferenceArray = { MeshVarReference, BadReference };
+
+		const FComponentReferenceSchema::FSchemaPtr StructSchema = FComponentReferenceSchema::Get(FBCRTestStruct::StaticStruct());
+		TestTrueExpr(StructSchema->GetEntries().Num() == 2);
+		TestTrueExpr(FComponentReferenceSchema::Get(FBCRTestStruct::StaticStruct()) == StructSchema);
+		TestTrueExpr(FComponentReferenceSchema::Get(FBCRTestStrustData::StaticStruct())->IsEmpty());
+
+		TArray<UActorComponent*> Resolved;
+		TestTrueExpr(StructSchema->Resolve(&SchemaStruct, TestActorReal, Resolved) == 2);
+		TestTrueExpr(Resolved.Num() == 3);
+		TestTrueExpr(Resolved[0] == TestActorReal->Default_Root);
+		TestTrueExpr(Resolved[1] == TestActorReal->GetMesh());
+		TestTrueExpr(Resolved[2] == nullptr);
+
+		TestActorReal->StructTestArray = { SchemaStruct };
+		TestActorReal->StructTest.Reference = MeshPathReference;
+
+		TArray<FBlueprintComponentReference> Visited;
+		const FComponentReferenceSchema::FSchemaPtr ActorSchema = FComponentReferenceSchema::Get(ABCRTestActor::StaticClass());
+		ActorSchema->ForEachReference(TestActorReal, [&Visited](const FBlueprintComponentReference& InReference)
+		{
+			Visited.Add(InReference);
+		});
+		TestTrueExpr(Visited.Contains(TestActorReal->ReferenceVar));
+		TestTrueExpr(Visited.Contains(MeshPathReference));
+		TestTrueExpr(Visited.Contains(MeshVarReference));
+		TestTrueExpr(Visited.Contains(BadReference));
+
+		const FProperty* VarField = nullptr;
+		ActorSchema->ForEachReferenceField(TestActorReal, [&](const FProperty* InField, const FBlueprintComponentReference& InReference)
+		{
+			if (&InReference == &TestActorReal->ReferenceVar)
+			{
+				VarField = InField;
+			}
+		});
+		TestTrueExpr(VarField && VarField->GetFName() == GET_MEMBER_NAME_CHECKED(ABCRTestActor, ReferenceVar));
+		TestTrueExpr(FComponentReferenceSchema::WarmupActor(TestActorReal) > 0);
+
+		// fields with ActorClass metadata are described as well, metadata does not survive cooking
+		TestTrueExpr(FComponentReferenceSchema::Get(UBCRTestDataAsset::StaticClass())->GetEntries().Num() == 5);
+
+		TestActorReal->StructTestArray.Reset();
+		TestActorReal->StructTest.Reference.Invalidate();
+	}
+
+	// warmup subsystem
+	if (UBlueprintComponentReferenceSubsystem* Subsystem = World->GetSubsystem<UBlueprintComponentReferenceSubsystem>())
+	{
+		while (Subsystem->GetNumPending() > 0)
+		{
+			Subsystem->Tick(0.f);
+		}
+
+		Subsystem->RequestWarmup(TestActorReal);
+		Subsystem->RequestWarmup(TestActorReal2);
+		Subsystem->RequestWarmup(World->SpawnActor<AActor>());
+		Subsystem->RequestWarmup(nullptr);
+		TestTrueExpr(Subsystem->GetNumPending() == 2);
+
+		Subsystem->Tick(0.f);
+		Subsystem->Tick(0.f);
+		TestTrueExpr(Subsystem->GetNumPending() == 0);
+
+		Subsystem->NotifyActorReused(TestActorReal);
+		Subsystem->NotifyComponentsChanged(TestActorReal);
+		TestTrueExpr(Subsystem->GetNumPending() == 1);
+		Subsystem->Tick(0.f);
+		TestTrueExpr(Subsystem->GetNumPending() == 0);
+		TestTrueExpr(MeshPathReference.GetComponent(TestActorReal) == TestActorReal->GetMesh());
+
+		// spawned actor is only queued, queue is drained on tick
+		ABCRTestActor* Spawned = World->SpawnActor<ABCRTestActor>();
+		TestTrueExpr(Subsystem->GetNumPending() > 0);
+		while (Subsystem->GetNumPending() > 0)
+		{
+			Subsystem->Tick(0.f);
+		}
+
+		// component created in initialized actor only marks it dirty, it is warmed again on next tick
+		const uint32 SpawnedGeneration = FBlueprintComponentReferenceCache::GetActorGeneration(Spawned);
+		auto* Added = NewObject<UBCRTestSceneComponent>(Spawned);
+		Added->RegisterComponent();
+		TestTrueExpr(Subsystem->GetNumPending() == 0);
+		TestTrueExpr(FBlueprintComponentReferenceCache::GetActorGeneration(Spawned) == 0);
+		Subsystem->Tick(0.f);
+		TestTrueExpr(Subsystem->GetNumPending() == 0);
+		const uint32 AddedGeneration = FBlueprintComponentReferenceCache::GetActorGeneration(Spawned);
+		TestTrueExpr(AddedGeneration != 0);
+		TestTrueExpr(AddedGeneration != SpawnedGeneration);
+
+		// destroyed component is picked up by recheck of tracked actors
+		Added->DestroyComponent();
+		Subsystem->Tick(0.f);
+		TestTrueExpr(Subsystem->GetNumPending() == 0);
+		TestTrueExpr(FBlueprintComponentReferenceCache::GetActorGeneration(Spawned) != AddedGeneration);
+		TestTrueExpr(FBlueprintComponentReferenceCache::GetActorGeneration(Spawned) != 0);
+
+		Spawned->Destroy();
+	}
+
+	// cook validation
+	TestTrue("CookValidator.Property", FBlueprintComponentReferenceCache::CanResolveInClass(TestBaseReference, ABCRTestActor::StaticClass()));
+	TestTrue("CookValidator.Path", FBlueprintComponentReferenceCache::CanResolveInClass(MeshPathReference, ABCRTestActor::StaticClass()));
+	TestTrue("CookValidator.Var", FBlueprintComponentReferenceCache::CanResolveInClass(MeshVarReference, ABCRTestActor::StaticClass()));
+	TestFalse("CookValidator.Bad", FBlueprintComponentReferenceCache::CanResolveInClass(BadReference, ABCRTestActor::StaticClass()));
+	TestFalse("CookValidator.BadPath", FBlueprintComponentReferenceCache::CanResolveInClass(FBlueprintComponentReference::ForPath(TEXT("DoesNotExist")), ABCRTestActor::StaticClass()));
+	// test actor has bad path in ReferenceBadPath and bad property in ReferenceBadVar and each container
+	AddExpectedError(TEXT("Non_Existent_Path"), EAutomationExpectedErrorFlags::Contains, 2);
+	AddExpectedError(TEXT("NonExistingComponent"), EAutomationExpectedErrorFlags::Contains, 8);
+	TestTrue("CookValidator.Actor", FBlueprintComponentReferenceCookValidator::ValidateObject(TestActorReal) == 5);
+	TestTrue("CookValidator.Default", FBlueprintComponentReferenceCookValidator::ValidateObject(TestActorDefault) == 5);
+
+	UBCRTestDataAsset* ValidatedAsset = NewObject<UBCRTestDataAsset>();
+	ValidatedAsset->ReferenceArray = { TestBaseReference, MeshPathReference, BadReference };
+	ValidatedAsset->ReferenceSet = { BadReference };
+	ValidatedAsset->ReferenceMap.Reset();
+	AddExpectedError(TEXT("DoesNotExist"), EAutomationExpectedErrorFlags::Contains, 2);
+	TestTrue("CookValidator.DataAsset", FBlueprintComponentReferenceCookValidator::ValidateObject(ValidatedAsset) == 2);
+
+	//======================================
+	// nested references into child actor
+
+	ABCRTestActorWithChild* ParentActor = World->SpawnActor<ABCRTestActorWithChild>();
+	ADefaultPawn* ChildActor = Cast<ADefaultPawn>(ParentActor->LevelNope->GetChildActor());
+	TestTrueExpr(ChildActor != nullptr);
+	if (ChildActor)
+	{
+		const TConstArrayView<FName> Segments = FBlueprintComponentReferenceCache::FindPathSegments(TEXT("LevelNope.CollisionComponent"));
+		TestTrueExpr(Segments.Num() == 2 && Segments[0] == TEXT("LevelNope") && Segments[1] == TEXT("CollisionComponent"));
+		TestTrueExpr(Segments.GetData() == FBlueprintComponentReferenceCache::FindPathSegments(TEXT("LevelNope.CollisionComponent")).GetData());
+
+		const FBlueprintComponentReference NestedProperty(TEXT("nested:LevelNope.CollisionComponent"));
+		const FBlueprintComponentReference NestedPath = FBlueprintComponentReference::ForNested(*FString::Printf(TEXT("LevelNope.%s"), *ADefaultPawn::MeshComponentName.ToString()));
+		const FBlueprintComponentReference NestedSingle = FBlueprintComponentReference::ForNested(TEXT("LevelNope"));
+		const FBlueprintComponentReference NestedBadHop = FBlueprintComponentReference::ForNested(TEXT("Default_Root.CollisionComponent"));
+		const FBlueprintComponentReference NestedBadLeaf = FBlueprintComponentReference::ForNested(TEXT("LevelNope.DoesNotExist"));
+
+		TestTrueExpr(NestedProperty.GetMode() == EBlueprintComponentReferenceMode::Nested);
+		TestTrueExpr(NestedProperty.ToString() == TEXT("nested:LevelNope.CollisionComponent"));
+		TestTrueExpr(NestedProperty.GetComponent(ParentActor) == ChildActor->GetCollisionComponent());
+		TestTrueExpr(NestedPath.GetComponent(ParentActor) == ChildActor->GetMeshComponent());
+		TestTrueExpr(NestedSingle.GetComponent(ParentActor) == ParentActor->LevelNope);
+		TestTrueExpr(NestedBadHop.GetComponent(ParentActor) == nullptr);
+		TestTrueExpr(NestedBadLeaf.GetComponent(ParentActor) == nullptr);
+		TestTrueExpr(NestedProperty.GetComponent(TestActorReal) == nullptr);
+
+		FResolvedComponentReferenceHandle Handle(NestedProperty, ABCRTestActorWithChild::StaticClass());
+		TestTrueExpr(Handle.GetComponent(ParentActor) == ChildActor->GetCollisionComponent());
+
+		TestTrueExpr(FComponentReferenceLiterals::IsValidFor(NestedProperty, ABCRTestActorWithChild::StaticClass()));
+		TestTrueExpr(!FComponentReferenceLiterals::IsValidFor(NestedBadLeaf, ABCRTestActorWithChild::StaticClass()));
+		TestTrueExpr(FBlueprintComponentReferenceCache::CanResolveInClass(NestedProperty, ABCRTestActorWithChild::StaticClass()));
+		TestTrueExpr(!FBlueprintComponentReferenceCache::CanResolveInClass(NestedProperty, ABCRTestActor::StaticClass()));
+		// child actor class is set in defaults, so path is followed to the leaf
+		TestTrueExpr(FBlueprintComponentReferenceCache::CanResolveInClass(NestedPath, ABCRTestActorWithChild::StaticClass()));
+		TestTrueExpr(FBlueprintComponentReferenceCache::CanResolveInClass(NestedSingle, ABCRTestActorWithChild::StaticClass()));
+		TestTrueExpr(!FBlueprintComponentReferenceCache::CanResolveInClass(NestedBadHop, ABCRTestActorWithChild::StaticClass()));
+		TestTrueExpr(!FBlueprintComponentReferenceCache::CanResolveInClass(NestedBadLeaf, ABCRTestActorWithChild::StaticClass()));
+	}
+
+	//======================================
+	// dynamic selection by tag and class
+
+	{
+		const FBlueprintComponentReference ByTag = FBlueprintComponentReference::ForTag(TEXT("Weakpoint"));
+		const FBlueprintComponentReference ByMeshClass = FBlueprintComponentReference::ForClass(USkeletalMeshComponent::StaticClass());
+		const FBlueprintComponentReference ByTestClass = FBlueprintComponentReference::ForClass(UBCRTestActorComponent::StaticClass());
+		const FBlueprintComponentReference BadSelector(TEXT("dynamic:Weakpoint"));
+		const FBlueprintComponentReference BadClass(TEXT("dynamic:Class:/Script/Engine.DoesNotExist"));
+
+		TestTrueExpr(ByTag.ToString() == TEXT("dynamic:Tag:Weakpoint"));
+		TestTrueExpr(ByTag.GetMode() == EBlueprintComponentReferenceMode::Dynamic);
+		TestTrueExpr(ByMeshClass.ToString() == TEXT("dynamic:Class:/Script/Engine.SkeletalMeshComponent"));
+
+		const FComponentReferenceSelector TagSelector = FBlueprintComponentReferenceCache::FindSelector(ByTag.GetValue());
+		TestTrueExpr(TagSelector.Kind == FComponentReferenceSelector::EKind::Tag && TagSelector.Tag == TEXT("Weakpoint"));
+		const FComponentReferenceSelector ClassSelector = FBlueprintComponentReferenceCache::FindSelector(ByMeshClass.GetValue());
+		TestTrueExpr(ClassSelector.Kind == FComponentReferenceSelector::EKind::Class && ClassSelector.Class == USkeletalMeshComponent::StaticClass());
+		TestTrueExpr(!FBlueprintComponentReferenceCache::FindSelector(BadSelector.GetValue()).IsValid());
+		TestTrueExpr(!FBlueprintComponentReferenceCache::FindSelector(BadClass.GetValue()).IsValid());
+
+		TestTrueExpr(ByMeshClass.GetComponent(TestActorReal) == TestActorReal->GetMesh());
+		TestTrueExpr(ByMeshClass.GetComponent(TestActorReal2) == TestActorReal2->GetMesh());
+		UActorComponent* const FoundTestComponent = ByTestClass.GetComponent(TestActorReal);
+		TestTrueExpr(FoundTestComponent && FoundTestComponent->IsA<UBCRTestActorComponent>() && FoundTestComponent->GetOwner() == TestActorReal);
+		TestTrueExpr(BadSelector.GetComponent(TestActorReal) == nullptr);
+		TestTrueExpr(BadClass.GetComponent(TestActorReal) == nullptr);
+
+		TestTrueExpr(ByTag.GetComponent(TestActorReal) == nullptr);
+		TestActorReal->Default_LevelTwo->ComponentTags.Add(TEXT("Weakpoint"));
+		// misses are not remembered, tag added to existing component is found without invalidation
+		TestTrueExpr(ByTag.GetComponent(TestActorReal) == TestActorReal->Default_LevelTwo);
+		FBlueprintComponentReferenceCache::InvalidateActor(TestActorReal);
+		TestTrueExpr(ByTag.GetComponent(TestActorReal) == TestActorReal->Default_LevelTwo);
+		TestTrueExpr(ByTag.GetComponent(TestActorReal2) == nullptr);
+
+		// removed tag is detected on lookup
+		TestActorReal->Default_LevelTwo->ComponentTags.Remove(TEXT("Weakpoint"));
+		TestTrueExpr(ByTag.GetComponent(TestActorReal) == nullptr);
+
+		// added component is picked up without invalidation
+		UBCRTestActorComponent* Tagged = NewObject<UBCRTestActorComponent>(TestActorReal, TEXT("Playtime_Tagged"));
+		Tagged->ComponentTags.Add(TEXT("Weakpoint"));
+		Tagged->RegisterComponent();
+		TestTrueExpr(ByTag.GetComponent(TestActorReal) == Tagged);
+
+		FResolvedComponentReferenceHandle Handle(ByTag, ABCRTestActor::StaticClass());
+		TestTrueExpr(Handle.GetComponent(TestActorReal) == Tagged);
+
+		TestTrueExpr(FComponentReferenceLiterals::IsValidFor(ByTag, ABCRTestActor::StaticClass()));
+		TestTrueExpr(!FComponentReferenceLiterals::IsValidFor(BadSelector, ABCRTestActor::StaticClass()));
+		TestTrueExpr(FBlueprintComponentReferenceCache::CanResolveInClass(ByMeshClass, ABCRTestActor::StaticClass()));
+		TestTrueExpr(!FBlueprintComponentReferenceCache::CanResolveInClass(BadClass, ABCRTestActor::StaticClass()));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintComponentReferenceTests_GetReferencedComponentNode,
+	"BlueprintComponentReference.GetReferencedComponentNode", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+namespace BCRNodeTest
+{
+	static const FName EventName(TEXT("RunReferenceTest"));
+	static const FName ResultName(TEXT("Result"));
+	static const FName FoundName(TEXT("Found"));
+
+	/**
+	 * Compile actor blueprint with event that resolves reference with UK2Node_GetReferencedComponent
+	 * and stores component and success into member variables
+	 */
+	static UClass* CompileResolveBlueprint(const TCHAR* InReference)
+	{
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+		UBlueprint* const Blueprint = FKismetEditorUtilities::CreateBlueprint(ABCRTestActor::StaticClass(), GetTransientPackage(),
+			MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), TEXT("BCRTestNodeBlueprint")),
+			BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+		UEdGraph* const Graph = FBlueprintEditorUtils::FindEventGraph(Blueprint);
+		if (!Graph)
+		{
+			return nullptr;
+		}
+
+		FBlueprintEditorUtils::AddMemberVariable(Blueprint, ResultName, FEdGraphPinType(UEdGraphSchema_K2::PC_Object, NAME_None, UActorComponent::StaticClass(), EPinContainerType::None, false, FEdGraphTerminalType()));
+		FBlueprintEditorUtils::AddMemberVariable(Blueprint, FoundName, FEdGraphPinType(UEdGraphSchema_K2::PC_Boolean, NAME_None, nullptr, EPinContainerType::None, false, FEdGraphTerminalType()));
+
+		FGraphNodeCreator<UK2Node_CustomEvent> EventCreator(*Graph);
+		UK2Node_CustomEvent* EventNode = EventCreator.CreateNode();
+		EventNode->CustomFunctionName = EventName;
+		EventCreator.Finalize();
+
+		FGraphNodeCreator<UK2Node_GetReferencedComponent> ResolveCreator(*Graph);
+		UK2Node_GetReferencedComponent* ResolveNode = ResolveCreator.CreateNode();
+		ResolveCreator.Finalize();
+		Schema->TrySetDefaultValue(*ResolveNode->FindPinChecked(TEXT("Reference")), InReference);
+
+		UEdGraphPin* Then = EventNode->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+		for (const FName& Name : { ResultName, FoundName })
+		{
+			FGraphNodeCreator<UK2Node_VariableSet> SetCreator(*Graph);
+			UK2Node_VariableSet* SetNode = SetCreator.CreateNode();
+			SetNode->VariableReference.SetSelfMember(Name);
+			SetCreator.Finalize();
+
+			UEdGraphPin* ValuePin = Name == ResultName ? ResolveNode->FindPinChecked(TEXT("Component")) : ResolveNode->GetReturnValuePin();
+			Schema->TryCreateConnection(Then, SetNode->FindPinChecked(UEdGraphSchema_K2::PN_Execute));
+			Schema->TryCreateConnection(ValuePin, SetNode->FindPinChecked(Name));
+			Then = SetNode->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+		}
+
+		FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+		return Blueprint->Status == BS_UpToDate ? Blueprint->GeneratedClass.Get() : nullptr;
+	}
+
+	/** Count references to function in bytecode of class own functions */
+	static int32 CountCalls(const UClass* InClass, const UFunction* InFunction)
+	{
+		int32 NumCalls = 0;
+		for (TFieldIterator<UFunction> It(InClass, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+		{
+			const TArray<uint8>& Script = It->Script;
+			for (int32 Offset = 0; Offset + (int32)sizeof(UFunction*) <= Script.Num(); ++Offset)
+			{
+				const UFunction* Called = nullptr;
+				FMemory::Memcpy(&Called, &Script[Offset], sizeof(Called));
+				NumCalls += Called == InFunction;
+			}
+		}
+		return NumCalls;
+	}
+}
+
+bool FBlueprintComponentReferenceTests_GetReferencedComponentNode::RunTest(FString const&)
+{
+	FTestWorldScope World;
+
+	const UFunction* LibraryFunction = UBlueprintComponentReferenceLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UBlueprintComponentReferenceLibrary, GetReferencedComponent));
+
+	// literal property reference with self actor compiles to variable get and cast
+	UClass* const LiteralClass = BCRNodeTest::CompileResolveBlueprint(TEXT("(Mode=Property,Value=\"Default_Root\")"));
+	// path reference is resolved through library call
+	UClass* const FallbackClass = BCRNodeTest::CompileResolveBlueprint(TEXT("(Mode=Path,Value=\"Default_LevelZero\")"));
+	TestTrueExpr(LiteralClass != nullptr);
+	TestTrueExpr(FallbackClass != nullptr);
+	if (!LiteralClass || !FallbackClass)
+	{
+		return false;
+	}
+
+	TestTrueExpr(BCRNodeTest::CountCalls(LiteralClass, LibraryFunction) == 0);
+	TestTrueExpr(BCRNodeTest::CountCalls(FallbackClass, LibraryFunction) > 0);
+
+	ABCRTestActor* const LiteralActor = World->SpawnActor<ABCRTestActor>(LiteralClass);
+	ABCRTestActor* const FallbackActor = World->SpawnActor<ABCRTestActor>(FallbackClass);
+	TestTrueExpr(LiteralActor != nullptr);
+	TestTrueExpr(FallbackActor != nullptr);
+	if (!LiteralActor || !FallbackActor)
+	{
+		return false;
+	}
+
+	auto RunEvent = [](ABCRTestActor* InActor, UObject*& OutResult, bool& bOutFound)
+	{
+		InActor->ProcessEvent(InActor->FindFunctionChecked(BCRNodeTest::EventName), nullptr);
+		OutResult = CastFieldChecked<FObjectPropertyBase>(InActor->GetClass()->FindPropertyByName(BCRNodeTest::ResultName))->GetObjectPropertyValue_InContainer(InActor);
+		bOutFound = CastFieldChecked<FBoolProperty>(InActor->GetClass()->FindPropertyByName(BCRNodeTest::FoundName))->GetPropertyValue_InContainer(InActor);
+	};
+
+	UObject* Result = nullptr;
+	bool bFound = false;
+
+	RunEvent(LiteralActor, Result, bFound);
+	TestTrueExpr(bFound);
+	TestTrueExpr(Result == LiteralActor->Default_Root);
+
+	RunEvent(FallbackActor, Result, bFound);
+	TestTrueExpr(bFound);
+	TestTrueExpr(Result == FallbackActor->Default_LevelZero);
+
 	return true;
 }
 